@@ -3,6 +3,12 @@
 
 #include <Wt/Auth/AuthWidget>
 
+#include "Liveness.h"
+
+namespace Wt {
+  class WPushButton;
+}
+
 class Session;
 
 class AuthWidget : public Wt::Auth::AuthWidget
@@ -13,8 +19,17 @@ public:
   /* We will use a custom registration view */
   virtual Wt::WWidget *createRegistrationView(const Wt::Auth::Identity& id);
 
+protected:
+  /* Our login button and password field check the password on the hash workers */
+  virtual void createPasswordLoginView();
+
 private:
+  Liveness liveness_;                   /*!< drops password checks that finish after this is deleted */
   Session& session_;
+  Wt::WPushButton *loginButton_;
+
+  void passwordLogin();
+  void passwordChecked();
 };
 
 #endif // AUTH_WIDGET_H_
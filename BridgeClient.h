@@ -0,0 +1,152 @@
+/** @file BridgeClient.h
+*  @brief Shared HTTP client used for every request sent to a Hue bridge
+*
+*   Instead of every widget creating its own Wt::Http::Client (and a new TCP
+*   connection) per command, all bridge traffic goes through the single
+*   BridgeClient instance. It keeps one persistent keep-alive connection per
+*   bridge, keyed by (ip, port), and pipelines requests over it. Requests are
+*   released to the bridge by a BridgeScheduler that limits the command rate
+*   (the "bridge-commands-per-second" property, 10 by default) and the
+*   requests waiting per priority (the "bridge-queue-limit" property, 200 by
+*   default). Every response is also applied to the bridge's BridgeModel.
+*
+*   Callbacks have the same signature as Http::Client::done(), so existing
+*   handleHttpResponse*() functions can be used unchanged. When a request is
+*   made from inside a Wt session the callback is posted back into that
+*   session, exactly like Http::Client does, and if the session has server
+*   push enabled whatever the callback changed is pushed to the browser.
+*/
+
+#ifndef BRIDGECLIENT_H_
+#define BRIDGECLIENT_H_
+
+#include <map>
+#include <string>
+
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <Wt/Http/Message>
+
+class BridgeConnection;
+class BridgeScheduler;
+
+/** @brief A single request to a bridge
+ */
+struct BridgeRequest
+{
+  /** @brief order in which queued requests are sent
+   */
+  enum Priority {
+    Interactive = 0,                  /*!< a user clicked or dragged something */
+    Effect = 1,                       /*!< presets and animated effects */
+    Bulk = 2,                         /*!< background and whole-home operations */
+    PriorityCount = 3
+  };
+
+  BridgeRequest() : priority(Interactive) { }
+
+  std::string method;                 /*!< GET, PUT, POST or DELETE */
+  std::string ip;                     /*!< bridge's IP address */
+  std::string port;                   /*!< bridge's port number */
+  std::string path;                   /*!< request path, e.g. /api/<user>/lights */
+  std::string body;                   /*!< request body, empty for GET/DELETE */
+  Priority priority;                  /*!< scheduling priority */
+};
+
+class BridgeClient
+{
+public:
+  typedef boost::function<void (boost::system::error_code, const Wt::Http::Message&)> Callback;
+
+  /** @brief the server-wide bridge client
+  *
+  *  @return BridgeClient
+  */
+  static BridgeClient& instance();
+
+  /** @brief sends a GET request to a bridge
+  *
+  *  @param ip the bridge's IP address
+  *  @param port the bridge's port number
+  *  @param path the request path (starting with /api)
+  *  @param done called with the response (inside the calling session, if any), may be empty
+  *  @param priority scheduling priority
+  *  @return false if the bridge address is invalid or its queue is full, and nothing was sent
+  */
+  bool get(const std::string& ip, const std::string& port,
+	   const std::string& path, const Callback& done,
+	   BridgeRequest::Priority priority = BridgeRequest::Interactive);
+
+  /** @brief sends a PUT request to a bridge
+  *
+  *  @return false if the bridge address is invalid or its queue is full, and nothing was sent
+  */
+  bool put(const std::string& ip, const std::string& port,
+	   const std::string& path, const std::string& body, const Callback& done,
+	   BridgeRequest::Priority priority = BridgeRequest::Interactive);
+
+  /** @brief sends a POST request to a bridge
+  *
+  *  @return false if the bridge address is invalid or its queue is full, and nothing was sent
+  */
+  bool post(const std::string& ip, const std::string& port,
+	    const std::string& path, const std::string& body, const Callback& done,
+	    BridgeRequest::Priority priority = BridgeRequest::Interactive);
+
+  /** @brief sends a DELETE request to a bridge
+  *
+  *  @return false if the bridge address is invalid or its queue is full, and nothing was sent
+  */
+  bool deleteRequest(const std::string& ip, const std::string& port,
+		     const std::string& path, const Callback& done,
+		     BridgeRequest::Priority priority = BridgeRequest::Interactive);
+
+  /** @brief queues a request on the bridge's scheduler
+  *
+  *  Unlike get()/put()/post(), the callback is not posted into a session: it
+  *  is called directly from the server's I/O thread.
+  *
+  *  @param request the request
+  *  @param done called with the response
+  *  @return false if the bridge address is invalid or its queue is full, and nothing was sent
+  */
+  bool send(const BridgeRequest& request, const Callback& done);
+
+  /** @brief how many more requests of a priority the bridge's queue takes now
+  *
+  *  @param ip the bridge's IP address
+  *  @param port the bridge's port number
+  *  @param priority the priority the requests would be sent with
+  *  @param room set to the number of requests
+  *  @return false if the bridge address is invalid
+  */
+  bool room(const std::string& ip, const std::string& port,
+	    BridgeRequest::Priority priority, std::size_t& room);
+
+  /** @brief wraps a callback so that it runs inside the current session
+  *
+  *  If there is no current session the callback is returned as is.
+  *
+  *  @param done the callback
+  *  @return the wrapped callback
+  */
+  static Callback bindToSession(const Callback& done);
+
+private:
+  BridgeClient();
+
+  boost::mutex mutex_;                                                 /*!< protects schedulers_ */
+  std::map<std::string, boost::shared_ptr<BridgeScheduler> > schedulers_;  /*!< one scheduler (and connection) per ip:port */
+  double rate_;                                                        /*!< commands per second per bridge, 0 until read */
+  std::size_t maxQueued_;                                              /*!< requests queued per priority per bridge */
+
+  boost::shared_ptr<BridgeScheduler> scheduler(const std::string& ip, const std::string& port);
+  bool request(const std::string& method, const std::string& ip, const std::string& port,
+	       const std::string& path, const std::string& body, const Callback& done,
+	       BridgeRequest::Priority priority);
+};
+
+#endif //BRIDGECLIENT_H_
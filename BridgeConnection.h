@@ -0,0 +1,111 @@
+/** @file BridgeConnection.h
+*  @brief A persistent HTTP/1.1 connection to a single Hue bridge
+*
+*   Used by BridgeClient. Requests are written back-to-back (pipelined, up to
+*   a small limit) over one keep-alive socket and the responses are matched
+*   to them in order. If the bridge closes an idle connection, unanswered
+*   idempotent requests are retried once on a fresh connection.
+*
+*   All state is only touched from the connection's strand. The time from
+*   a request being queued here to its response, and the requests that
+*   failed or timed out, are recorded in the server's Metrics per bridge.
+*/
+
+#ifndef BRIDGECONNECTION_H_
+#define BRIDGECONNECTION_H_
+
+#include <chrono>
+#include <deque>
+#include <string>
+
+#include <boost/asio.hpp>
+#include <boost/enable_shared_from_this.hpp>
+
+#include "BridgeClient.h"
+#include "Metrics.h"
+
+class BridgeConnection : public boost::enable_shared_from_this<BridgeConnection>
+{
+public:
+  /** @brief creates an (unconnected) connection to a bridge
+  *
+  *  @param io the server's I/O service
+  *  @param ip the bridge's IP address
+  *  @param port the bridge's port number
+  */
+  BridgeConnection(boost::asio::io_service& io, const std::string& ip, const std::string& port);
+
+  /** @brief queues a request, connecting first if needed
+  *
+  *  @param request the request
+  *  @param done called from the I/O thread with the response
+  */
+  void enqueue(const BridgeRequest& request, const BridgeClient::Callback& done);
+
+  static const std::size_t MaxPipeline = 4;               /*!< requests written before their response arrives */
+  static const std::size_t MaxResponseSize = 1024 * 1024; /*!< larger responses are rejected */
+  static const int TimeoutSeconds = 15;                   /*!< time to wait for a response */
+
+private:
+  struct Pending
+  {
+    std::string data;                    /*!< the serialized request */
+    bool idempotent;                     /*!< safe to send again (not a POST) */
+    int attempts;                        /*!< number of times it has been retried */
+    BridgeClient::Callback done;         /*!< response handler */
+    Metrics::Histogram *latency;         /*!< of the endpoint it was sent to */
+    std::chrono::steady_clock::time_point queued;
+  };
+
+  static const int EndpointCount = 6;    /*!< /api, lights, groups, schedules, config and the rest */
+
+  boost::asio::io_service::strand strand_;
+  boost::asio::ip::tcp::resolver resolver_;
+  boost::asio::ip::tcp::socket socket_;
+  boost::asio::deadline_timer timer_;
+  std::string ip_;
+  std::string port_;
+  Metrics::Histogram *latency_[EndpointCount];
+  Metrics::Counter *timeouts_;
+  Metrics::Counter *errors_;             /*!< failed other than by a timeout */
+
+  std::deque<Pending> waiting_;          /*!< not yet written */
+  std::deque<Pending> inFlight_;         /*!< written, waiting for a response */
+
+  bool connected_;
+  bool connecting_;
+  bool writing_;
+  bool reading_;
+  bool reused_;                          /*!< at least one response was read on this socket */
+
+  boost::asio::streambuf buffer_;
+  Wt::Http::Message response_;
+  std::size_t contentLength_;
+  bool chunked_;
+  bool untilClose_;                      /*!< no length given: body ends when the bridge closes */
+  bool closeAfter_;                      /*!< bridge sent Connection: close */
+
+  void doEnqueue(const Pending& pending);
+  void startConnect();
+  void handleResolve(const boost::system::error_code& err,
+		     boost::asio::ip::tcp::resolver::iterator endpoints);
+  void handleConnect(const boost::system::error_code& err);
+  void pump();
+  void handleWrite(const boost::system::error_code& err);
+  void startRead();
+  void handleHeaders(const boost::system::error_code& err);
+  void readBody();
+  void handleBody(const boost::system::error_code& err);
+  void readChunkSize();
+  void handleChunkSize(const boost::system::error_code& err);
+  void readChunkData(std::size_t size);
+  void handleChunkData(const boost::system::error_code& err, std::size_t size);
+  void handleUntilClose(const boost::system::error_code& err);
+  void complete();
+  void fail(const boost::system::error_code& err);
+  void close();
+  void armTimer();
+  void handleTimeout(const boost::system::error_code& err);
+};
+
+#endif //BRIDGECONNECTION_H_
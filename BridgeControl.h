@@ -13,6 +13,7 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/system/system_error.hpp>
 #include <string>
+#include <vector>
 #include <Wt/WSound>
 
 
@@ -20,6 +21,9 @@
 #ifndef BRIDGECONTROL_H_
 #define BRIDGECONTROL_H_
 
+#include "HomeAction.h"
+#include "Liveness.h"
+
 class Session;
 
 class BridgeControlWidget : public Wt::WContainerWidget
@@ -37,6 +41,7 @@ public:
 	void update();
 
 private:
+	Liveness liveness_;								/*!< drops responses that arrive after this is deleted */
 	Session *session_;
 
 	Wt::WText *ip_;
@@ -52,6 +57,9 @@ private:
 	std::string ip;						/*!< string storing the user's IP address*/
 	std::string port;					/*!< string storing the bridge's port number*/
 	Wt::WText *confirm_;				/*!< textbox asking for confirmation from the user when they want to register a bridge*/
+	Wt::WText *homeReport_;				/*!< textbox showing the outcome of the last whole home action*/
+	Wt::WComboBox *homeScenes_;			/*!< the user's scenes, to apply to the whole home*/
+	std::vector<long long> homeSceneIds_;	/*!< ids of the scenes in homeScenes_*/
 
 	/**
 	* @brief Handles POST response and adds bridge to the database
@@ -68,14 +76,6 @@ private:
 	**/
 	void handleHttpResponse(boost::system::error_code err, const Wt::Http::Message& response);
 
-	/**
-	* @brief creates an HTTP client
-	*
-	* The client is used to make POST calls to the bridge in order to register the user to the bridge and using the returned username to add the bridge to the database
-	* @return Http::Client
-	*/
-	Wt::Http::Client * connect();
-
 	/**
 	* @brief Checks if the input is valid
 	*
@@ -93,6 +93,28 @@ private:
 	* @return Void.
 	**/
 	void showLights();
+
+	/**
+	* @brief Sets every light of every registered bridge at once
+	*
+	* The bridges are changed at the same time through HomeAction, homeReport_ shows the outcome once all of them answered
+	* @param state state to set the lights to
+	* @param what what is being done, e.g. "All on"
+	* @return Void.
+	**/
+	void setWholeHome(const LightCommand& state, const std::string& what);
+	void allOn();
+	void allOff();
+	void allScene();
+
+	/**
+	* @brief Shows the outcome of a whole home action
+	*
+	* @param what what was done
+	* @param report how each bridge did
+	* @return Void.
+	**/
+	void wholeHomeDone(const std::string& what, const HomeAction::Report& report);
 	
 	 Wt::WSound *messageReceived_;
 };
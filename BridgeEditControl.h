@@ -15,12 +15,14 @@
 #include <boost/system/system_error.hpp>
 #include <string>
 #include "Bridge.h"
+#include "Liveness.h"
 
 
 #ifndef BRIDGEEDITCONTROL_H_
 #define BRIDGEEDITCONTROL_H_
 
 class Session;
+struct Route;
 
 class BridgeEditControlWidget : public Wt::WContainerWidget
 {
@@ -45,7 +47,17 @@ public:
 	**/
 	void update();
 
+	/**
+	* @brief Shows the page for a bridge
+	*
+	* Keeps the bridge's IP address and port number from the route, then updates the page
+	* @param route the page and its parameters, parsed by HueApp
+	* @return Void.
+	**/
+	void update(const Route& route);
+
 private:
+	Liveness liveness_;								/*!< drops responses that arrive after this is deleted */
 	Session *session_;						/*!< keeps track of bridge information */
 	Bridge *thisBridge;						/*!< represents the current bridge */
 	Wt::WLineEdit *nameEdit_;				/*!< text input for the bridge's name*/
@@ -81,13 +93,6 @@ private:
 	**/
 	void handleHttpResponse(boost::system::error_code err, const Wt::Http::Message& response);
 
-	/** 
-	* @brief creates an HTTP client
-	* 
-	* The client is used to make POST calls to the bridge in order to register the user to the bridge and using the returned username to update the bridge in the database
-	* @return Http::Client
-	*/
-	Wt::Http::Client * connect();
 };
 
 #endif
@@ -0,0 +1,59 @@
+/** @file BridgeEndpoint.h
+*  @brief The request paths of one bridge user, built once and then reused
+*
+*   Every command used to build its path as "/api/" + userID + "/lights/" +
+*   id + "/state". A BridgeEndpoint holds the "/api/<user>" prefix and the
+*   path of each light and group it was asked for, so sending to the same
+*   light again costs a map lookup and no allocation. Together with
+*   LightCommand::write() and BridgeJson::Writer this keeps the path and the
+*   body of a command off the heap.
+*
+*   A BridgeEndpoint is not locked: it belongs to one widget or one effect.
+*/
+
+#ifndef BRIDGEENDPOINT_H_
+#define BRIDGEENDPOINT_H_
+
+#include <map>
+#include <string>
+
+class BridgeEndpoint
+{
+public:
+  BridgeEndpoint();
+  BridgeEndpoint(const std::string& ip, const std::string& port, const std::string& userId);
+
+  /** @brief moves to another bridge or user, dropping the cached paths if it is a different one
+  *
+  *  @param ip the bridge's IP address
+  *  @param port the bridge's port number
+  *  @param userId the bridge user id the paths are built for
+  */
+  void reset(const std::string& ip, const std::string& port, const std::string& userId);
+
+  const std::string& ip() const { return ip_; }
+  const std::string& port() const { return port_; }
+
+  /** @brief /api/<user> */
+  const std::string& prefix() const { return prefix_; }
+
+  /** @brief /api/<user>/lights/<id>/state */
+  const std::string& lightState(int light);
+  const std::string& lightState(const std::string& light);
+
+  /** @brief /api/<user>/groups/<id>/action */
+  const std::string& groupAction(int group);
+  const std::string& groupAction(const std::string& group);
+
+private:
+  std::string ip_;
+  std::string port_;
+  std::string userId_;
+  std::string prefix_;
+  std::map<int, std::string> lightStates_;    /*!< by light id */
+  std::map<int, std::string> groupActions_;   /*!< by group id */
+
+  const std::string& path(std::map<int, std::string>& paths, int id, const char *part, const char *suffix);
+};
+
+#endif //BRIDGEENDPOINT_H_
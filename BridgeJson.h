@@ -0,0 +1,216 @@
+/** @file BridgeJson.h
+*  @brief Typed decoding of bridge responses, and writing of request bodies
+*
+*   Parses /lights, /groups, /schedules and /config payloads in one pass over
+*   the response body, straight into the structs below. Object keys are
+*   compared in place and only the values that are kept are copied, so no
+*   intermediate DOM or substrings are built.
+*
+*   Numbers are also accepted as numeric strings ("254"), which is how older
+*   versions of this application stored them in the emulator.
+*
+*   Request bodies are written with a Writer, into a buffer of its own, so
+*   a command costs no allocation until it is handed over as a string.
+*/
+
+#ifndef BRIDGEJSON_H_
+#define BRIDGEJSON_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/utility/string_ref.hpp>
+
+/** @brief A light (GET /lights/<id>) or a group's last action
+ */
+struct LightState
+{
+  LightState() : on(false), bri(0), hue(0), sat(0), reachable(true) { }
+
+  std::string name;                   /*!< light name (empty for a group action) */
+  bool on;                            /*!< light is on */
+  int bri;                            /*!< brightness, 1 to 254 */
+  int hue;                            /*!< hue, 0 to 65535 */
+  int sat;                            /*!< saturation, 0 to 254 */
+  bool reachable;                     /*!< bridge can reach the light */
+};
+
+/** @brief A group (GET /groups/<id>)
+ */
+struct LightGroup
+{
+  std::string name;                   /*!< group name */
+  std::string type;                   /*!< LightGroup, Room, ... */
+  std::vector<int> lights;            /*!< ids of the lights in the group */
+  LightState action;                  /*!< last state set on the whole group */
+};
+
+/** @brief A schedule (GET /schedules/<id>)
+ */
+struct Schedule
+{
+  std::string name;                   /*!< schedule name */
+  std::string description;            /*!< schedule description */
+  std::string time;                   /*!< time (or localtime) the schedule fires */
+  std::string status;                 /*!< enabled or disabled */
+  std::string address;                /*!< command address, e.g. /api/<user>/groups/1/action */
+  std::string method;                 /*!< command method */
+  std::string body;                   /*!< command body, as raw JSON */
+};
+
+/** @brief The bridge configuration (GET /config)
+ */
+struct BridgeConfig
+{
+  std::string name;                   /*!< bridge name */
+  std::string apiVersion;             /*!< API version */
+  std::string swVersion;              /*!< software version */
+  std::string mac;                    /*!< MAC address */
+  std::string bridgeId;               /*!< bridge id */
+};
+
+namespace BridgeJson {
+
+  /** @brief A forward-only reader over a JSON document
+  *
+  *  After an error every call returns false; check failed() to tell an
+  *  error apart from the end of an object or array.
+  */
+  class Reader
+  {
+  public:
+    Reader(const char *begin, const char *end);
+
+    /** @brief consumes '{' */
+    bool beginObject();
+
+    /** @brief reads the next key of the current object
+    *
+    *  @param key set to the key, valid until the next call
+    *  @return false at the closing '}' (which is consumed)
+    */
+    bool nextKey(boost::string_ref& key);
+
+    /** @brief consumes '[' */
+    bool beginArray();
+
+    /** @brief moves to the next element of the current array
+    *
+    *  @return false at the closing ']' (which is consumed)
+    */
+    bool nextElement();
+
+    bool readString(std::string& value);
+    bool readInt(int& value);           /*!< also accepts a numeric string */
+    bool readBool(bool& value);
+
+    /** @brief copies the next value (of any type) as raw JSON */
+    bool readRaw(std::string& value);
+
+    /** @brief skips the next value, of any type */
+    bool skipValue();
+
+    /** @brief true if only whitespace is left */
+    bool atEnd();
+
+    bool failed() const { return failed_; }
+
+  private:
+    const char *pos_;
+    const char *end_;
+    bool failed_;
+    std::string scratch_;               /*!< decoded key, if it contained escapes */
+
+    void skipSpace();
+    bool expect(char c);
+    bool fail();
+    bool scanString(const char *& begin, const char *& end, bool& escaped);
+    void decode(const char *begin, const char *end, std::string& out);
+  };
+
+  /** @brief A JSON writer into a fixed buffer
+  *
+  *  Commas are put in as keys and values are added, so nothing has to be
+  *  taken back at the end. A document that does not fit is cut off and
+  *  overflowed() is set; state and schedule bodies are far smaller.
+  */
+  class Writer
+  {
+  public:
+    static const std::size_t Capacity = 1024;
+
+    Writer();
+
+    Writer& beginObject();
+    Writer& endObject();
+    Writer& beginArray();
+    Writer& endArray();
+
+    /** @brief starts a member of the current object, its value comes next */
+    Writer& key(boost::string_ref name);
+
+    Writer& number(int value);
+    Writer& boolean(bool value);
+    Writer& string(boost::string_ref value);   /*!< quoted and escaped */
+
+    /** @brief a value that already is JSON, copied as is */
+    Writer& raw(boost::string_ref json);
+
+    /** @brief what has been written, valid until the next change */
+    boost::string_ref str() const { return boost::string_ref(data_, size_); }
+
+    bool overflowed() const { return overflowed_; }
+
+    /** @brief starts a new document, in the same buffer */
+    void clear();
+
+  private:
+    char data_[Capacity];
+    std::size_t size_;
+    bool comma_;                        /*!< the next key or element needs a ',' before it */
+    bool overflowed_;
+
+    void separate();
+    void put(char c);
+    void put(const char *data, std::size_t size);
+  };
+
+  /** @brief parses GET /lights/<id> */
+  bool parseLight(const std::string& json, LightState& light);
+
+  /** @brief parses a state or action body, e.g. of PUT /lights/<id>/state
+  *
+  *  Only the fields present in the body are changed.
+  */
+  bool parseState(const std::string& json, LightState& state);
+
+  /** @brief parses GET /lights, keyed by light id */
+  bool parseLights(const std::string& json, std::map<int, LightState>& lights);
+
+  /** @brief parses GET /groups/<id> */
+  bool parseGroup(const std::string& json, LightGroup& group);
+
+  /** @brief parses GET /groups, keyed by group id */
+  bool parseGroups(const std::string& json, std::map<int, LightGroup>& groups);
+
+  /** @brief parses GET /schedules/<id> */
+  bool parseSchedule(const std::string& json, Schedule& schedule);
+
+  /** @brief parses GET /schedules, keyed by schedule id */
+  bool parseSchedules(const std::string& json, std::map<int, Schedule>& schedules);
+
+  /** @brief parses GET /config */
+  bool parseConfig(const std::string& json, BridgeConfig& config);
+
+  /** @brief the light ids as a comma separated list, e.g. "1,2,3" */
+  std::string lightList(const std::vector<int>& lights);
+
+  /** @brief the light ids as the JSON array a group takes, e.g. ["1","2","3"] */
+  std::string lightArray(const std::vector<int>& lights);
+
+  /** @brief appends a value as a quoted JSON string, escaping what needs it */
+  void appendString(std::string& out, const std::string& value);
+}
+
+#endif //BRIDGEJSON_H_
@@ -0,0 +1,133 @@
+/** @file BridgeModel.h
+*  @brief Server-wide cache of the lights, groups and schedules of a bridge
+*
+*   There is one BridgeModel per bridge user (ip:port and the user's bridge
+*   ID), shared by every session using that ID. Only GETs sent with the
+*   model's ID fill it, so a user whose ID the bridge does not accept never
+*   sees what the bridge told another user.
+*   Its state is published as an immutable Snapshot: readers on any thread
+*   just take the current snapshot, without locking, and keep using it for
+*   as long as they hold the pointer. Writers copy the snapshot, change the
+*   copy and publish it in one atomic store.
+*
+*   The model is written by BridgeClient: every successful GET of /lights,
+*   /groups or /schedules (or a single entry of them) replaces the cached
+*   data, and every successful PUT or DELETE is applied to it, so after a
+*   change the cache matches the bridge without fetching again. POSTs create
+*   entries with ids only the bridge knows, so they invalidate the part they
+*   touched.
+*
+*   Pages ask for a part with fetch(): if the cached part is younger than the
+*   "bridge-model-ttl" property (10 seconds by default) nothing is sent and
+*   the page renders from snapshot() right away. Concurrent fetches of the
+*   same part share a single GET.
+*/
+
+#ifndef BRIDGEMODEL_H_
+#define BRIDGEMODEL_H_
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/thread/mutex.hpp>
+
+#include "BridgeClient.h"
+#include "BridgeJson.h"
+
+class BridgeModel
+{
+public:
+  /** @brief the separately fetched parts of the model
+   */
+  enum Part {
+    Lights = 0,                       /*!< GET /lights */
+    Groups = 1,                       /*!< GET /groups */
+    Schedules = 2,                    /*!< GET /schedules */
+    PartCount = 3
+  };
+
+  /** @brief the state of a bridge at one point in time
+   */
+  struct Snapshot
+  {
+    Snapshot();
+
+    std::map<int, LightState> lights;     /*!< lights, by id */
+    std::map<int, LightGroup> groups;     /*!< groups, by id */
+    std::map<int, Schedule> schedules;    /*!< schedules, by id */
+
+    bool loaded[PartCount];                                /*!< the part was fetched and is still valid */
+    std::chrono::steady_clock::time_point loadedAt[PartCount];  /*!< when the part was last fetched */
+  };
+
+  typedef std::shared_ptr<const Snapshot> SnapshotPtr;
+
+  /** @brief the model of a bridge user, created on first use
+  *
+  *  @param ip the bridge's IP address
+  *  @param port the bridge's port number
+  *  @param userID user's bridge ID
+  *  @return BridgeModel
+  */
+  static BridgeModel& forBridge(const std::string& ip, const std::string& port, const std::string& userID);
+
+  /** @brief the model a request to /api/<user>/... is applied to
+  *
+  *  @param request the request
+  *  @return the model, null if the request's path has no user ID
+  */
+  static BridgeModel *forRequest(const BridgeRequest& request);
+
+  /** @brief the current state, safe to read from any thread */
+  SnapshotPtr snapshot() const;
+
+  /** @brief true if the part was fetched less than the TTL ago */
+  bool fresh(Part part) const;
+
+  /** @brief fetches a part from the bridge with the model's user ID, unless the cached one is fresh
+  *
+  *  If a GET is sent, done is called once the model has been updated with
+  *  the response (inside the calling session, if any). A page should then
+  *  render from snapshot().
+  *
+  *  @param part the part to fetch
+  *  @param done called with the response
+  *  @return true if a GET was sent (or one already in flight was joined), false if the cache is fresh or the bridge address is invalid
+  */
+  bool fetch(Part part, const BridgeClient::Callback& done);
+
+  /** @brief marks a part as stale, so that the next fetch() goes to the bridge */
+  void invalidate(Part part);
+
+  /** @brief applies a completed request to the model
+  *
+  *  Called by BridgeClient for every request to this bridge with the model's user ID.
+  *  A PUT to /groups/0/action, the group of every light, changes all lights.
+  *
+  *  @param request the request
+  *  @param err the response's error code
+  *  @param response the response
+  */
+  void update(const BridgeRequest& request, boost::system::error_code err,
+	      const Wt::Http::Message& response);
+
+private:
+  BridgeModel(const std::string& ip, const std::string& port, const std::string& userID);
+
+  std::string ip_;
+  std::string port_;
+  std::string userID_;
+  std::shared_ptr<const Snapshot> snapshot_;   /*!< only accessed with std::atomic_load/store */
+
+  boost::mutex mutex_;                         /*!< serializes writers and protects waiting_ */
+  std::vector<BridgeClient::Callback> waiting_[PartCount];  /*!< callbacks of the GET in flight, per part */
+
+  void fetched(Part part, boost::system::error_code err, const Wt::Http::Message& response);
+  void publish(const std::shared_ptr<Snapshot>& next);
+  std::shared_ptr<Snapshot> copy() const;
+};
+
+#endif //BRIDGEMODEL_H_
@@ -0,0 +1,106 @@
+/** @file BridgePoller.h
+*  @brief Polls a bridge in the background and pushes changes to the browser
+*
+*   There is one BridgePoller per bridge user, like the BridgeModel it
+*   watches (ip:port and the user's bridge ID). While at least one
+*   session is subscribed it fetches the bridge's lights and groups every
+*   "bridge-poll-interval" seconds (2 by default), at Bulk priority, no matter
+*   how many sessions are watching. The responses update the BridgeModel;
+*   the poller then compares the model with the snapshot it saw last time
+*   and posts only the lights and groups that changed to every subscribed
+*   session. Changes made through this application show up the same way,
+*   since they are applied to the model as well.
+*
+*   Callbacks run inside the subscribing session (through WServer::post),
+*   after which the session's changes are pushed to the browser.
+*/
+
+#ifndef BRIDGEPOLLER_H_
+#define BRIDGEPOLLER_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/asio/deadline_timer.hpp>
+#include <boost/function.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include "BridgeModel.h"
+
+class BridgePoller
+{
+public:
+  /** @brief the lights and groups that changed since the previous poll
+   */
+  struct Delta
+  {
+    std::map<int, LightState> lights;     /*!< new or changed lights */
+    std::map<int, LightGroup> groups;     /*!< new or changed groups */
+    std::vector<int> removedLights;       /*!< ids of lights that are gone */
+    std::vector<int> removedGroups;       /*!< ids of groups that are gone */
+
+    bool empty() const;
+  };
+
+  typedef boost::function<void (const Delta&)> Callback;
+
+  /** @brief the poller of a bridge user, created on first use
+  *
+  *  @param ip the bridge's IP address
+  *  @param port the bridge's port number
+  *  @param userID user's bridge ID, used for the requests
+  *  @return BridgePoller
+  */
+  static BridgePoller& forBridge(const std::string& ip, const std::string& port, const std::string& userID);
+
+  /** @brief starts delivering changes to the current session
+  *
+  *  Must be called from inside a session, which needs server push enabled
+  *  (WApplication::enableUpdates()).
+  *
+  *  @param changed called inside the session with every non-empty delta
+  *  @return subscription id, for unsubscribe()
+  */
+  int subscribe(const Callback& changed);
+
+  /** @brief stops delivering changes
+  *
+  *  Must be called from inside the subscribing session (e.g. from the
+  *  subscribing widget's destructor): no callback runs after it returns.
+  *
+  *  @param id subscription id returned by subscribe()
+  */
+  void unsubscribe(int id);
+
+private:
+  struct Subscriber
+  {
+    std::string sessionId;
+    Callback changed;
+  };
+
+  BridgePoller(const std::string& ip, const std::string& port, const std::string& userID);
+
+  std::string ip_;
+  std::string port_;
+  std::string userID_;
+  boost::asio::deadline_timer timer_;
+  boost::posix_time::time_duration interval_;
+
+  boost::mutex mutex_;                          /*!< protects the members below */
+  std::map<int, Subscriber> subscribers_;       /*!< by subscription id */
+  int nextId_;
+  bool polling_;                                /*!< a poll is scheduled or in flight */
+  BridgeModel::SnapshotPtr previous_;           /*!< snapshot the last delta was computed against */
+
+  void schedule();
+  void poll(const boost::system::error_code& err);
+  void polledLights(boost::system::error_code err, const Wt::Http::Message& response);
+  void polledGroups(boost::system::error_code err, const Wt::Http::Message& response);
+  void deliver(int id, const Delta& delta);
+
+  static Delta diff(const BridgeModel::Snapshot& before, const BridgeModel::Snapshot& after);
+};
+
+#endif //BRIDGEPOLLER_H_
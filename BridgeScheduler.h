@@ -0,0 +1,121 @@
+/** @file BridgeScheduler.h
+*  @brief Rate limited, prioritized queue of the requests sent to one bridge
+*
+*   Bridges (and the emulator) stop responding above roughly 10 commands per
+*   second. Every request BridgeClient sends passes through the scheduler of
+*   its bridge, which releases them with a token bucket. Queued requests are
+*   released highest priority first (Interactive, then Effect, then Bulk) and
+*   round-robin between the bridge users (the <user> in /api/<user>/...), so
+*   one user's effect can't starve the other users of the same bridge.
+*
+*   Each priority holds at most a maximum number of requests; beyond it
+*   submit() refuses them, so a bridge that can't keep up fails requests
+*   right away instead of queueing them for minutes. The queue depth per
+*   priority, the requests sent and the time they waited are recorded in
+*   the server's Metrics per bridge.
+*/
+
+#ifndef BRIDGESCHEDULER_H_
+#define BRIDGESCHEDULER_H_
+
+#include <deque>
+#include <map>
+#include <string>
+
+#include <boost/asio.hpp>
+#include <boost/enable_shared_from_this.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include "BridgeClient.h"
+#include "Metrics.h"
+
+class BridgeConnection;
+
+class BridgeScheduler : public boost::enable_shared_from_this<BridgeScheduler>
+{
+public:
+  /** @brief queue statistics, see stats()
+   */
+  struct Stats
+  {
+    std::size_t queued[BridgeRequest::PriorityCount];  /*!< requests waiting, per priority */
+    unsigned long long sent;                           /*!< requests released so far */
+    unsigned long long totalWaitMs;                    /*!< sum of the time spent queued */
+    unsigned long long maxWaitMs;                      /*!< longest time a request was queued */
+    unsigned long long refused;                        /*!< requests refused because their priority was full */
+    double rate;                                       /*!< configured commands per second */
+    std::size_t maxQueued;                             /*!< requests queued per priority at most */
+  };
+
+  static const std::size_t DefaultMaxQueued = 200;    /*!< 20 seconds' worth at 10 commands per second */
+
+  /** @brief creates the scheduler for one bridge
+  *
+  *  @param io the server's I/O service
+  *  @param connection the bridge's connection
+  *  @param bridge ip:port, labels the bridge's metrics
+  *  @param rate commands per second released to the bridge, 10 if not positive
+  *  @param maxQueued requests queued per priority at most, DefaultMaxQueued if 0
+  */
+  BridgeScheduler(boost::asio::io_service& io,
+		  const boost::shared_ptr<BridgeConnection>& connection,
+		  const std::string& bridge, double rate, std::size_t maxQueued = 0);
+
+  /** @brief queues a request, it is sent right away if a token is available
+  *
+  *  @param request the request
+  *  @param done called from the I/O thread with the response
+  *  @return false if the request's priority already has maxQueued requests waiting, done is not called
+  */
+  bool submit(const BridgeRequest& request, const BridgeClient::Callback& done);
+
+  /** @brief current queue depth and wait times
+  *
+  *  @return Stats
+  */
+  Stats stats();
+
+private:
+  struct Item
+  {
+    BridgeRequest request;
+    BridgeClient::Callback done;
+    boost::posix_time::ptime queuedAt;
+  };
+
+  /* requests of one priority, a queue per bridge user plus the round-robin order */
+  struct Level
+  {
+    std::map<std::string, std::deque<Item> > byOwner;
+    std::deque<std::string> order;                   /*!< owners with queued requests, next one first */
+  };
+
+  boost::shared_ptr<BridgeConnection> connection_;
+  boost::asio::deadline_timer timer_;
+  boost::mutex mutex_;                               /*!< protects everything below */
+
+  std::size_t maxQueued_;                            /*!< per priority */
+  double rate_;                                      /*!< tokens added per second */
+  double burst_;                                     /*!< bucket size */
+  double tokens_;
+  boost::posix_time::ptime refilledAt_;
+  bool timerArmed_;
+
+  Level levels_[BridgeRequest::PriorityCount];
+  Stats stats_;
+
+  Metrics::Gauge *queued_[BridgeRequest::PriorityCount];
+  Metrics::Counter *sent_;
+  Metrics::Counter *refused_;
+  Metrics::Histogram *wait_;
+
+  static std::string owner(const BridgeRequest& request);
+
+  void refill(const boost::posix_time::ptime& now);
+  void dispatch();
+  bool popNext(Item& item);
+  void handleTimer(const boost::system::error_code& err);
+};
+
+#endif //BRIDGESCHEDULER_H_
@@ -0,0 +1,139 @@
+/** @file CommandQueue.h
+*  @brief Latest-wins queue for light and group state changes
+*
+*   Sliders fire a valueChanged event per step, which used to turn into one
+*   PUT per step. Commands sent through the CommandQueue are merged per target
+*   (a light's /state or a group's /action): while a request for a target is
+*   in flight, newer changes are folded into a single pending body that only
+*   keeps the newest value of each field, and is sent once the bridge answers.
+*   So there is at most one request in flight and one waiting per target.
+*
+*   A change may come with a callback, called with the response to the
+*   request its fields were sent in, which may carry later changes as well.
+*/
+
+#ifndef COMMANDQUEUE_H_
+#define COMMANDQUEUE_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/thread/mutex.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <Wt/Http/Message>
+
+#include "BridgeClient.h"
+
+namespace BridgeJson { class Reader; class Writer; }
+
+/** @brief A partial light state, only the fields that were set are sent
+ */
+class LightCommand
+{
+public:
+  LightCommand();
+
+  LightCommand& on(bool on);
+  LightCommand& hue(int hue);
+  LightCommand& sat(int sat);
+  LightCommand& bri(int bri);
+  LightCommand& transitionTime(int time);
+
+  /** @brief copies every field set in other into this command (other wins)
+  */
+  void merge(const LightCommand& other);
+
+  /** @brief true if no field is set
+  */
+  bool empty() const { return fields_ == 0; }
+
+  /** @brief the JSON body for a /state or /action PUT, e.g. {"on":true,"bri":200}
+  */
+  std::string toJson() const;
+
+  /** @brief writes the JSON body into out, without allocating
+  *
+  *  @param out writer positioned where the object goes
+  */
+  void write(BridgeJson::Writer& out) const;
+
+  /** @brief reads a body like the one toJson() writes, adding its fields
+  *
+  *  @param in reader positioned at the object
+  *  @return false if the JSON is invalid or has a field other than on, hue, sat, bri and transitiontime
+  */
+  bool read(BridgeJson::Reader& in);
+
+private:
+  enum Field {
+    On             = 0x01,
+    Hue            = 0x02,
+    Sat            = 0x04,
+    Bri            = 0x08,
+    TransitionTime = 0x10
+  };
+
+  int fields_;                          /*!< bitmask of the fields that are set */
+  bool on_;
+  int hue_;
+  int sat_;
+  int bri_;
+  int transitionTime_;
+};
+
+class CommandQueue
+{
+public:
+  /** @brief the server-wide command queue
+  *
+  *  @return CommandQueue
+  */
+  static CommandQueue& instance();
+
+  /** @brief queues a state change for a light or group
+  *
+  *  @param ip the bridge's IP address
+  *  @param port the bridge's port number
+  *  @param path the target, e.g. /api/<user>/lights/1/state or /api/<user>/groups/2/action
+  *  @param command the fields to change, nothing is done if it is empty
+  *  @param priority scheduling priority (merged changes keep the highest)
+  *  @param done called from the I/O thread with the response to the request
+  *         the change went out in, or with NotSent if it could not be sent
+  */
+  void submit(const std::string& ip, const std::string& port,
+	      const std::string& path, const LightCommand& command,
+	      BridgeRequest::Priority priority = BridgeRequest::Interactive,
+	      const BridgeClient::Callback& done = BridgeClient::Callback());
+
+  /** @brief the error done is called with when BridgeClient::send() refused the request
+   */
+  static const boost::system::errc::errc_t NotSent = boost::system::errc::resource_unavailable_try_again;
+
+private:
+  typedef std::vector<BridgeClient::Callback> Callbacks;
+
+  struct Target
+  {
+    std::string ip;
+    std::string port;
+    std::string path;
+    LightCommand pending;               /*!< merged changes not sent yet */
+    BridgeRequest::Priority priority;   /*!< priority of the pending changes */
+    bool inFlight;                      /*!< a request for this target is waiting for its response */
+    Callbacks pendingDone;              /*!< callbacks of the changes in pending */
+    Callbacks inFlightDone;             /*!< callbacks of the changes in flight */
+  };
+
+  CommandQueue();
+
+  boost::mutex mutex_;                  /*!< protects targets_ */
+  std::map<std::string, Target> targets_;  /*!< keyed by ip:port/path */
+
+  bool sendPending(const std::string& key, Target& target);
+  static void notSent(const Callbacks& callbacks);
+  void handleResponse(std::string key, boost::system::error_code err, const Wt::Http::Message& response);
+};
+
+#endif //COMMANDQUEUE_H_
@@ -0,0 +1,91 @@
+/** @file ControlResource.h
+*  @brief JSON API at /control for changing lights without a browser session
+*
+*   Registered by main() as a static resource, so scripts can set many lights
+*   and groups with one request and no WApplication is created for them. The
+*   request is authenticated with the user's "remember me" token, sent as
+*   'Authorization: Bearer <token>' or in the hueappcookie cookie:
+*
+*     POST /control
+*     {"commands":[{"bridge":"192.168.1.2:80","lights":[1,2],"groups":[3],
+*                   "state":{"on":true,"bri":200,"hue":8000,"sat":120,"transitiontime":4}}]}
+*
+*   A command without lights and groups sets the bridge's group 0 (all of its
+*   lights). Every target is sent through the CommandQueue, so the bridge's
+*   rate limit still applies and changes to a light that arrive while one is
+*   in flight, from this request or others, go out merged in one PUT. The
+*   response is sent once all bridges have answered:
+*
+*     {"results":[{"bridge":"192.168.1.2:80","light":1,"success":true,"response":[...]}, ...]}
+*
+*   or after TimeoutSeconds, when targets not answered yet fail. A request
+*   with more targets for a bridge than its queue takes (see BridgeClient)
+*   is refused with 503 and a Retry-After header, so clients slow down
+*   instead of piling up requests the bridge can't send for minutes.
+*
+*   Nothing waits on a server thread in the meantime: the response is
+*   completed from a continuation. Tokens are checked against the database
+*   once and then kept for a short while, so a script sending many requests
+*   does not cost a query per request.
+*/
+
+#ifndef CONTROLRESOURCE_H_
+#define CONTROLRESOURCE_H_
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/system/error_code.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <Wt/WResource>
+#include <Wt/Http/Message>
+#include <Wt/Dbo/SqlConnectionPool>
+
+class Session;
+
+class ControlResource : public Wt::WResource
+{
+public:
+  static const unsigned MaxTargets = 1000;        /*!< lights and groups in one request */
+  static const unsigned MaxBodySize = 1 << 20;    /*!< request body, in bytes */
+  static const int TimeoutSeconds = 30;           /*!< targets not answered by then fail */
+  static const int RetryAfterSeconds = 10;        /*!< sent with a 503 when a bridge is busy */
+
+  ControlResource(Wt::Dbo::SqlConnectionPool& connectionPool, Wt::WObject *parent = 0);
+  ~ControlResource();
+
+protected:
+  virtual void handleRequest(const Wt::Http::Request& request, Wt::Http::Response& response);
+
+private:
+  /* what a token gives access to, see grant() */
+  struct Grant
+  {
+    bool valid;                                   /*!< the token belongs to a user */
+    std::map<std::string, std::string> bridges;   /*!< the user's bridge user ids by ip:port */
+    std::chrono::steady_clock::time_point expires;
+  };
+
+  struct Batch;
+
+  Wt::Dbo::SqlConnectionPool& connectionPool_;
+
+  boost::mutex mutex_;                            /*!< protects grants_ and sessions_ */
+  std::map<std::string, boost::shared_ptr<const Grant> > grants_;   /*!< by token */
+  std::vector<std::unique_ptr<Session> > sessions_;                 /*!< idle database sessions */
+
+  boost::shared_ptr<const Grant> grant(const std::string& token);
+  static void error(Wt::Http::Response& response, int status, const std::string& message);
+  static void completed(boost::shared_ptr<Batch> batch, std::size_t index,
+			boost::system::error_code err, const Wt::Http::Message& response);
+  static void failed(boost::shared_ptr<Batch> batch, std::size_t index, const std::string& message);
+  static void finished(boost::shared_ptr<Batch> batch);
+  static void timedOut(boost::shared_ptr<Batch> batch, const boost::system::error_code& err);
+};
+
+#endif //CONTROLRESOURCE_H_
@@ -0,0 +1,111 @@
+/** @file EffectEngine.h
+*  @brief Plays animated light effects on asio timers
+*
+*   An effect is a sequence of frames (the state of each of its lights)
+*   played at a fixed frame rate. Every effect has its own timer on the
+*   server's io service, so playing one neither blocks a session nor a
+*   worker thread, and any number of effects can run at the same time.
+*   Frames are sent through the CommandQueue at Effect priority: when a
+*   bridge cannot keep up, a light simply skips to the newest frame.
+*
+*   Effects are identified by a target (e.g. the group they animate);
+*   playing an effect on a target replaces the one already running there.
+*   Effects keep running when the page that started them is closed.
+*/
+
+#ifndef EFFECTENGINE_H_
+#define EFFECTENGINE_H_
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/asio/deadline_timer.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include "BridgeEndpoint.h"
+#include "CommandQueue.h"
+
+class EffectEngine
+{
+public:
+  /** @brief one step of an effect: the changes to send to each light, by light id
+   */
+  typedef std::vector<std::pair<int, LightCommand> > Frame;
+
+  /** @brief a keyframe sequence and how to play it
+   */
+  struct Effect
+  {
+    Effect() : framesPerSecond(4), loops(1) { }
+
+    std::string ip;                     /*!< bridge's IP address */
+    std::string port;                   /*!< bridge's port number */
+    std::string userID;                 /*!< user's bridge ID */
+    std::vector<Frame> frames;          /*!< played in order */
+    int framesPerSecond;                /*!< frame rate */
+    int loops;                          /*!< times the frames are played, 0 plays until stopped */
+  };
+
+  enum State {
+    Stopped,
+    Playing,
+    Paused
+  };
+
+  /** @brief the server-wide effect engine
+  *
+  *  @return EffectEngine
+  */
+  static EffectEngine& instance();
+
+  /** @brief starts playing an effect, replacing the one playing on the target
+  *
+  *  @param target what the effect animates, e.g. ip:port/groups/1
+  *  @param effect the effect
+  */
+  void play(const std::string& target, const Effect& effect);
+
+  /** @brief pauses the effect playing on a target, it can be resumed
+  */
+  void pause(const std::string& target);
+
+  /** @brief continues a paused effect with its next frame
+  */
+  void resume(const std::string& target);
+
+  /** @brief stops the effect on a target, the lights keep their current state
+  */
+  void stop(const std::string& target);
+
+  /** @brief whether an effect is playing or paused on a target
+  */
+  State state(const std::string& target);
+
+private:
+  struct Running
+  {
+    Running(boost::asio::io_service& ioService, const Effect& effect);
+
+    Effect effect;
+    boost::asio::deadline_timer timer;
+    std::size_t frame;                  /*!< next frame to send */
+    int loop;                           /*!< loops completed */
+    bool paused;
+    unsigned generation;                /*!< bumped on pause/resume, so that stale timer callbacks are ignored */
+    BridgeEndpoint endpoint;            /*!< has the path of every light of the effect, only read once playing */
+  };
+
+  EffectEngine();
+
+  boost::mutex mutex_;                  /*!< protects effects_ and the Running entries */
+  std::map<std::string, boost::shared_ptr<Running> > effects_;  /*!< by target */
+
+  void step(std::string target, boost::shared_ptr<Running> running, unsigned generation,
+	    const boost::system::error_code& err);
+};
+
+#endif //EFFECTENGINE_H_
@@ -0,0 +1,98 @@
+/** @file EmulatedBridge.h
+*  @brief The state of an emulated Hue bridge and its REST API
+*
+*   Backs the hue_emulator program ('make emulator'), an in-tree replacement
+*   for the external emulator this application was developed against. It
+*   keeps any number of virtual lights, their groups, schedules and the
+*   bridge configuration in memory and answers /api requests the way a v1
+*   Hue bridge does: JSON objects keyed by id for GET, and arrays of
+*   "success"/"error" objects for PUT, POST and DELETE. Group light lists
+*   are sent as arrays of strings, schedules carry both "time" and
+*   "localtime", so the differences between the old emulator's versions do
+*   not matter.
+*
+*   Every user name is accepted, the bridge is always "linked". Requests
+*   may be handled from any thread.
+*/
+
+#ifndef EMULATEDBRIDGE_H_
+#define EMULATEDBRIDGE_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/thread/mutex.hpp>
+
+#include "BridgeJson.h"
+
+/** @brief The answer to a request, before it is written as HTTP
+ */
+struct EmulatorResponse
+{
+  EmulatorResponse() : status(200) { }
+
+  int status;                           /*!< HTTP status code */
+  std::string body;                     /*!< JSON body */
+};
+
+class EmulatedBridge
+{
+public:
+  /** @brief what the bridge starts with
+   */
+  struct Options
+  {
+    Options() : lights(50), groups(5), name("Hue Emulator") { }
+
+    int lights;                         /*!< virtual lights, ids 1 to lights */
+    int groups;                         /*!< groups, the lights are spread over them */
+    std::string name;                   /*!< bridge name in /config */
+  };
+
+  explicit EmulatedBridge(const Options& options);
+
+  /** @brief answers one request
+  *
+  *  @param method GET, PUT, POST or DELETE
+  *  @param path the request path, e.g. /api/<user>/lights/3/state
+  *  @param body the request body
+  *  @param response set to the answer
+  */
+  void handle(const std::string& method, const std::string& path,
+	      const std::string& body, EmulatorResponse& response);
+
+  int lightCount() const { return lights_.size(); }
+
+private:
+  typedef std::vector<std::string> Segments;
+
+  boost::mutex mutex_;
+  std::vector<LightState> lights_;      /*!< light id - 1 */
+  std::map<int, LightGroup> groups_;
+  std::map<int, Schedule> schedules_;
+  BridgeConfig config_;
+  int nextUser_;                        /*!< number in the next user name handed out */
+  std::string lightsJson_;              /*!< GET /lights, kept until a light changes */
+  bool lightsChanged_;                  /*!< lightsJson_ is out of date */
+
+  void handleApi(const std::string& method, const Segments& path,
+		 const std::string& body, EmulatorResponse& response);
+  void handleLights(const std::string& method, const Segments& path,
+		    const std::string& body, EmulatorResponse& response);
+  void handleGroups(const std::string& method, const Segments& path,
+		    const std::string& body, EmulatorResponse& response);
+  void handleSchedules(const std::string& method, const Segments& path,
+		       const std::string& body, EmulatorResponse& response);
+  void handleConfig(const std::string& method, const Segments& path,
+		    const std::string& body, EmulatorResponse& response);
+
+  const std::string& lightsJson();
+  void appendGroups(std::string& out) const;
+  void appendSchedules(std::string& out) const;
+  void appendConfig(std::string& out) const;
+  LightGroup allLights() const;         /*!< group 0 */
+  bool validLights(const std::vector<int>& lights) const;
+};
+
+#endif //EMULATEDBRIDGE_H_
@@ -0,0 +1,99 @@
+/** @file EmulatorServer.h
+*  @brief HTTP/1.1 front end of the emulated Hue bridge
+*
+*   Accepts keep-alive connections (pipelined requests are answered in
+*   order) and hands every request to an EmulatedBridge. To behave like a
+*   real bridge under load it can delay responses, fail a share of them
+*   with 503 and a bridge "internal error", answer changes above a rate
+*   limit with 429, and close connections that have been idle too long.
+*/
+
+#ifndef EMULATORSERVER_H_
+#define EMULATORSERVER_H_
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+#include <boost/asio.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
+class EmulatedBridge;
+struct EmulatorResponse;
+
+class EmulatorServer
+{
+public:
+  /** @brief how the server listens and misbehaves
+   */
+  struct Options
+  {
+    Options() : address("127.0.0.1"), port("8000"), threads(1), latencyMs(0),
+		jitterMs(0), errorRate(0), changesPerSecond(0), idleMs(0) { }
+
+    std::string address;                /*!< address to listen on */
+    std::string port;                   /*!< port to listen on, "0" picks a free one */
+    int threads;                        /*!< threads running the I/O service */
+    int latencyMs;                      /*!< delay before every response */
+    int jitterMs;                       /*!< up to this much is added to the delay, at random */
+    double errorRate;                   /*!< share of requests answered with 503, 0 to 1 */
+    int changesPerSecond;               /*!< PUT/POST/DELETE allowed per second (with a burst of as many), 0 for no limit */
+    int idleMs;                         /*!< keep-alive connections idle this long are closed, 0 to keep them open */
+  };
+
+  /** @brief listens right away, serves once run() is called
+  *
+  *  @throws boost::system::system_error if the address can not be bound
+  */
+  EmulatorServer(EmulatedBridge& bridge, const Options& options);
+
+  /** @brief serves until SIGINT or SIGTERM, or until stop() */
+  void run();
+
+  void stop();
+
+  /** @brief the port listened on, useful with port "0" */
+  unsigned short port() const;
+
+  /** @brief answers one request, applying the error rate and rate limit
+  *
+  *  @param random a random number in [0, 1) drawn by the connection
+  */
+  void handle(const std::string& method, const std::string& path,
+	      const std::string& body, double random, EmulatorResponse& response);
+
+  /** @brief the delay before a response, given a random number in [0, 1) */
+  int delayMs(double random) const;
+
+  boost::asio::io_service& ioService() { return io_; }
+
+  /** @brief requests answered so far, including failed ones */
+  unsigned long requests() const { return requests_; }
+
+  /** @brief connections accepted so far */
+  unsigned long connections() const { return connections_; }
+
+private:
+  class Connection;
+  typedef std::chrono::steady_clock Clock;
+
+  EmulatedBridge& bridge_;
+  Options options_;
+  boost::asio::io_service io_;
+  boost::asio::ip::tcp::acceptor acceptor_;
+  boost::asio::signal_set signals_;
+  std::atomic<unsigned long> requests_;
+  std::atomic<unsigned long> connections_;
+
+  boost::mutex rateMutex_;
+  double tokens_;                       /*!< changes that may be made right now */
+  Clock::time_point refilled_;          /*!< tokens_ was last topped up */
+
+  void startAccept();
+  void handleAccept(const boost::shared_ptr<Connection>& connection,
+		    const boost::system::error_code& err);
+  bool admitChange();
+};
+
+#endif //EMULATORSERVER_H_
@@ -9,11 +9,15 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/system/system_error.hpp>
 #include <Wt/WContainerWidget>
+#include "BridgePoller.h"
+#include "Liveness.h"
 
 #ifndef GROUPCONTROL_H_
 #define GROUPCONTROL_H_
 
+class LightsModel;
 class Session;
+struct Route;
 
 class GroupsControlWidget: public Wt::WContainerWidget
 {
@@ -28,6 +32,12 @@ public:
 	*  @return GroupsControlWidget
 	*/
 	GroupsControlWidget(Session *session, Wt::WContainerWidget *parent = 0);
+
+	/** @brief destroys a GroupsControlWidget
+	*
+	*  stops receiving changes from the bridge's BridgePoller
+	*/
+	~GroupsControlWidget();
 	
 	/** @brief loads SingleGroupsControlWidget page
 	*
@@ -37,71 +47,74 @@ public:
 	*/
 	void update();
 
+	/** @brief loads the GroupsControlWidget page for the bridge of a route
+	*
+	*  keeps the route's parameters, then calls update()
+	*
+	*  @param route the page and its parameters, parsed by HueApp
+	*  @return Void
+	*/
+	void update(const Route& route);
+
 private:
+	Liveness liveness_;								/*!< drops responses that arrive after this is deleted */
 	Session *session_;										/*!< keeps track of group status */
 	std::string ip = "";									/*!< bridge's IP address */
 	std::string userID = "";								/*!< user's bridge ID */
 	std::string port = "";									/*!< bridge's port number */
-	bool one = false;										/*!< status of light 1's membership in the new group */
-	bool two = false;										/*!< status of light 2's membership in the new group */
-	bool three = false;										/*!< status of light 3's membership in the new group */
 	Wt::WLineEdit *nameEdit_;								/*!< new group's name */
-	Wt::WText *light1_;										/*!< displays whether light 1 is part of the new group */
-	Wt::WText *light2_;										/*!< displays whether light 2 is part of the new group */
-	Wt::WText *light3_;										/*!< displays whether light 3 is part of the new group */
+	LightsModel *lightsModel_;								/*!< the bridge's lights, by id */
+	Wt::WTableView *lightsView_;							/*!< lights to choose from for the new group */
 	Wt::WText *status_;										/*!< status of creating a group */
+	Wt::WContainerWidget *groupsList_;						/*!< buttons of the current groups */
+	Wt::WText *userInfo_;									/*!< greets the user */
+	Wt::WPushButton *lightButton_;							/*!< links back to the bridge's lights */
+	int subscription_ = -1;									/*!< BridgePoller subscription, -1 if none */
 
-	/** @brief creates an HTTP Client
-	*
-	*  creates an HTTP client that will be used to send either a post request to create a new group or a get request to retrieve the currently existing groups
-	*
-	*  @return Http::Client
-	*/
-	Wt::Http::Client * connect();
-
-	/** @brief selects light 1 to be added to the group
+	/** @brief creates a new group
 	*
-	*  includes light 1 to be a part of the new group. If clicked again, light 1 will not be part of the new group.
+	*  gets user information about the name and lights of the new group and sends a post request to create the group. Then update() is called to refresh the list of groups
 	*
 	*  @return Void
 	*/
-	void lightOne();
+	void createGroup();
 
-	/** @brief selects light 2 to be added to the group
+	/** @brief returns user to bridge page
 	*
-	*  includes light 2 to be a part of the new group. If clicked again, light 2 will not be part of the new group.
+	*  returns user the bridge page by setting the internal path
 	*
 	*  @return Void
 	*/
-	void lightTwo();
+	void returnBridge();
 
-	/** @brief selects light 3 to be added to the group
+	/** @brief displays the groups
 	*
-	*  includes light 3 to be a part of the new group. If clicked again, light 3 will not be part of the new group.
+	*  (re)displays each group in the bridge's model as button that leads to the SingleGroupsControlWidget where user can edit a specific group
 	*
 	*  @return Void
 	*/
-	void lightThree();
+	void showGroups();
 
-	/** @brief creates a new group
+	/** @brief displays the lights
 	*
-	*  gets user information about the name and lights of the new group and sends a post request to create the group. Then update() is called to refresh the list of groups
+	*  fills the table of lights that can be chosen for a new group from the bridge's model
 	*
 	*  @return Void
 	*/
-	void createGroup();
+	void showLights();
 
-	/** @brief returns user to bridge page
+	/** @brief shows changes to the lights and groups
 	*
-	*  returns user the bridge page by setting the internal path
+	*  updates the table of lights and redisplays the groups when they were changed on the bridge. Called by the bridge's BridgePoller
 	*
+	*  @param delta the lights and groups that changed
 	*  @return Void
 	*/
-	void returnBridge();
+	void bridgeChanged(const BridgePoller::Delta& delta);
 
 	/** @brief handles response and displays group information
 	*
-	*  gets the list of groups and displays each one as button that leads to the SingleGroupsControlWidget where user can edit a specific group
+	*  displays the groups with showGroups() once the bridge's model has been fetched
 	*
 	*  @param err the response's error code
 	*  @param response the response
@@ -118,6 +131,16 @@ private:
 	*  @return Void
 	*/
 	void handleHttpResponseVOID(boost::system::error_code err, const Wt::Http::Message& response);
+
+	/** @brief handles response and displays the lights
+	*
+	*  displays the lights with showLights() once the bridge's model has been fetched
+	*
+	*  @param err the response's error code
+	*  @param response the response
+	*  @return Void
+	*/
+	void handleHttpResponseLights(boost::system::error_code err, const Wt::Http::Message& response);
 };
 
 #endif
@@ -8,11 +8,16 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/system/system_error.hpp>
 #include <Wt/WContainerWidget>
+#include "BridgeEndpoint.h"
+#include "Liveness.h"
 
 #ifndef GROUPSSCHEDULERCONTROL_H_
 #define GROUPSSCHEDULERCONTROL_H_
 
+class LightCommand;
 class Session;
+struct Route;
+class TimeOptionsModel;
 
 class GroupsSchedulerControlWidget: public Wt::WContainerWidget
 {
@@ -35,21 +40,35 @@ public:
   */
   void update();
 
+  /** @brief loads the GroupsSchedulerControlWidget page for the group of a route
+  *
+  *  keeps the route's parameters, then calls update()
+  *
+  *  @param route the page and its parameters, parsed by HueApp
+  *  @return Void
+  */
+  void update(const Route& route);
+
 private:
+  Liveness liveness_;                     /*!< drops responses that arrive after this is deleted */
   Session *session_;                      /*!< keeps track of light status */
   std::string ip = "";                    /*!< Variable for ip */
   std::string userID = "";                /*!< Variable for userID */
   std::string port = "";                  /*!< Variable for Port */
   std::string groupID = "";               /*!< Variable for groupID */
+  BridgeEndpoint endpoint_;               /*!< the bridge's request paths */
   std::string lights;                     /*!< Variable for lights */
   bool deleteConfirm;                     /*!< Delete Confirmation */
   Wt::WText *groupInfoEdit_;              /*!< Displays the group Info */
   Wt::WText *groupLightsEdit_;            /*!< Displays the group Lights */
   Wt::WCalendar *calendar_;               /*!< Displays the Calendar */
+  Wt::WCheckBox *days_[7];                /*!< Repeats the schedule every week on the checked days, Monday first */
   Wt::WText *dateSelect_;                 /*!< Displays the DateSelect */
   Wt::WComboBox *hourInput_ ;             /*!< Displays the Hour Input */
   Wt::WComboBox *minInput_ ;              /*!< Displays the Min Input */
   Wt::WComboBox *secInput_ ;              /*!< Displays the Seconds Input */
+  TimeOptionsModel *hoursModel_;          /*!< Hours 01-12 for the Hour Input */
+  TimeOptionsModel *sixtyModel_;          /*!< 00-59 for the Min and Seconds Inputs */
   Wt::WComboBox *amSelector_;             /*!< Displays the Am/Pm Selector */
   Wt::WLineEdit *hueEdit_;                /*!< Displays the Hue Edit */
   Wt::WSlider *satScaleSlider_;           /*!< Creates Slider for Saturations */
@@ -58,6 +77,9 @@ private:
   Wt::WSlider *transitionScaleSlider_;    /*!< Creates Slider for Transition Time */
   Wt::WText *change_;                     /*!< Displays the Current Change */
   Wt::WPushButton *scheduleButton;        /*!< Create Schedule Button */
+  Wt::WText *userInfo_;                   /*!< Displays the greeting */
+  Wt::WPushButton *groupButton_;          /*!< Link back to the Groups page */
+  Wt::WPushButton *lightButton_;          /*!< Link back to the Lights page */
 
 
   int stateOn;                            /*!< Variable for Light State */
@@ -73,13 +95,14 @@ private:
   std::string Datasec;                    /*!< Variable for Sec of Data */
   std::string DatamerDes;                 /*!< Variable for AM/PM of Data */
 
-  /** @brief Handles Https Connect 
+  /** @brief Shows the group
   *
-  *  Connects to Https
+  *  Displays the group's name and lights from the bridge's model
   *
   *  @return Void
   */
-  Wt::Http::Client * connect();
+  void showGroup();
+
   /** @brief Handles Https Reponse V1
   *
   *  Handles the Https Response for basic
@@ -203,7 +226,7 @@ private:
 
   /** @brief Creates a new schedule
   *
-  *  New Schedule is Created
+  *  New Schedule is Created, on the bridge or, if the server keeps schedules, in the database
   *
   *  @return Void
   */  
@@ -233,27 +256,27 @@ private:
   */  
   void changeSec(); 
 
-  /** @brief Creates a get Signal
+  /** @brief Creates the schedule's command
   *
-  *  Creates the body of the get signal
+  *  Collects the light changes that were chosen, the body of the command the schedule sends
   *
-  *  @return Void
+  *  @return LightCommand
   */
-  std::string createBodyMessage();
+  LightCommand createCommand();
 
   /** @brief Creates a Post Signal
   *
-  *  Creates the body of the post signal
+  *  Creates the body of the post signal, written without building intermediate strings
   *
-  *  @return Void
+  *  @return std::string, empty if it does not fit in a BridgeJson::Writer
   */
   std::string createPostMessage();
 
   /** @brief Creates a Date and Time 
   *
-  *  Creates the body of the post signal
+  *  Creates the time the schedule fires, e.g. 2017-11-28T18:30:00, or W124/T18:30:00 when days are checked
   *
-  *  @return Void
+  *  @return std::string
   */
   std::string createDateTime();
 
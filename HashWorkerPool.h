@@ -0,0 +1,64 @@
+/** @file HashWorkerPool.h
+*  @brief A fixed number of threads for password hashing
+*
+*   bcrypt is slow on purpose (tens of milliseconds per hash). Run on the
+*   Wt request threads, a burst of logins takes all of them and every other
+*   session waits. Hashing jobs are queued here instead and run by a fixed
+*   number of threads, so at most that many cores hash at any time while
+*   the request threads keep serving pages.
+*/
+
+#ifndef HASHWORKERPOOL_H_
+#define HASHWORKERPOOL_H_
+
+#include <deque>
+
+#include <boost/function.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+class HashWorkerPool
+{
+public:
+  typedef boost::function<void ()> Job;
+
+  /** @brief starts the worker threads
+  *
+  *  @param threads number of jobs run at the same time, 0 for one per core
+  */
+  explicit HashWorkerPool(int threads);
+
+  /** @brief runs the jobs still queued, then stops the threads
+  */
+  ~HashWorkerPool();
+
+  /** @brief queues a job, it is run on one of the pool's threads
+  */
+  void submit(const Job& job);
+
+  /** @brief runs a job on the pool and waits for it to finish
+  *
+  *  For the callers that need the result right away. The calling thread is
+  *  still blocked, but no more than threads() jobs hash at the same time.
+  */
+  void run(const Job& job);
+
+  /** @brief number of worker threads
+  */
+  int threads() const { return workers_.size(); }
+
+private:
+  boost::mutex mutex_;                  /*!< protects jobs_ and stopping_ */
+  boost::condition_variable queued_;    /*!< signalled when a job is queued or the pool stops */
+  std::deque<Job> jobs_;
+  bool stopping_;
+  boost::thread_group workers_;
+
+  HashWorkerPool(const HashWorkerPool&);
+  HashWorkerPool& operator=(const HashWorkerPool&);
+
+  void work();
+};
+
+#endif //HASHWORKERPOOL_H_
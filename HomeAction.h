@@ -0,0 +1,129 @@
+/** @file HomeAction.h
+*  @brief Applies one change to every light of all of a user's bridges at once
+*
+*   The bridges are worked on at the same time, so a whole-home action takes
+*   about as long as the slowest bridge rather than the sum of them. A state
+*   that is the same for every light is one PUT of the bridge's group 0 (all
+*   of its lights). A scene, where each light gets its own state, is one PUT
+*   per light it has a state for, with the body the SceneCache prepared: the bridge's
+*   lights are taken from its BridgeModel (fetched first if they are not
+*   cached) and at most MaxInFlight of them are sent to a bridge at a time,
+*   behind the other users' interactive requests.
+*
+*   Responses are collected on the server's I/O thread and reported once,
+*   when every bridge is done, inside the session that started the action.
+*/
+
+#ifndef HOMEACTION_H_
+#define HOMEACTION_H_
+
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include <boost/enable_shared_from_this.hpp>
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/system/error_code.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <Wt/Http/Message>
+
+#include "Bridge.h"
+#include "CommandQueue.h"
+#include "SceneCache.h"
+
+class HomeAction : public boost::enable_shared_from_this<HomeAction>
+{
+public:
+  static const unsigned MaxInFlight = 4;    /*!< requests outstanding per bridge */
+
+  /** @brief how one bridge did
+   */
+  struct BridgeResult
+  {
+    BridgeResult() : succeeded(0), failed(0) { }
+
+    std::string name;                   /*!< bridge name */
+    std::string address;                /*!< ip:port */
+    unsigned succeeded;                 /*!< lights or groups changed */
+    unsigned failed;                    /*!< lights or groups not changed */
+    std::string error;                  /*!< first error, empty if there was none */
+  };
+
+  /** @brief the outcome of an action, over all bridges
+   */
+  struct Report
+  {
+    Report() : succeeded(0), failed(0) { }
+
+    std::vector<BridgeResult> bridges;  /*!< in the order they were given */
+    unsigned succeeded;
+    unsigned failed;
+    std::chrono::milliseconds elapsed;  /*!< from the start until the last bridge answered */
+  };
+
+  typedef boost::function<void (const Report&)> Done;
+
+  /** @brief sets every light of the bridges to the same state
+  *
+  *  @param bridges the bridges, e.g. Session::getBridges()
+  *  @param state the state
+  *  @param done called with the report (inside the calling session, if any)
+  */
+  static void setAll(const std::vector<Bridge>& bridges, const LightCommand& state, const Done& done);
+
+  /** @brief applies a scene to every light of the bridges
+  *
+  *  Each light of a bridge gets the scene's body for it: the state saved for
+  *  its id, or the n-th state for the n-th light (by id) of a positional scene.
+  *
+  *  @param bridges the bridges, e.g. Session::getBridges()
+  *  @param scene the scene, e.g. Session::scene()
+  *  @param done called with the report (inside the calling session, if any)
+  */
+  static void apply(const std::vector<Bridge>& bridges, const SceneCache::EntryPtr& scene, const Done& done);
+
+private:
+  /* one PUT */
+  struct Change
+  {
+    std::string path;
+    std::string body;
+  };
+
+  /* the bridge's changes still to send */
+  struct Dispatch
+  {
+    Dispatch() : inFlight(0), done(false) { }
+
+    std::string ip;
+    std::string port;
+    std::string userId;
+    std::deque<Change> queue;
+    unsigned inFlight;
+    bool done;
+    BridgeResult result;
+  };
+
+  boost::mutex mutex_;                  /*!< protects bridges_ and remaining_ */
+  std::vector<Dispatch> bridges_;
+  std::size_t remaining_;               /*!< bridges not done yet */
+  SceneCache::EntryPtr scene_;          /*!< null when setting one state */
+  Done done_;
+  std::string sessionId_;               /*!< session done_ is called in, empty for none */
+  std::chrono::steady_clock::time_point start_;
+
+  HomeAction(const std::vector<Bridge>& bridges, const SceneCache::EntryPtr& scene, const Done& done);
+
+  void start(const LightCommand *state);
+  void lightsFetched(std::size_t bridge, boost::system::error_code err, const Wt::Http::Message& response);
+  void completed(std::size_t bridge, boost::system::error_code err, const Wt::Http::Message& response);
+  void pump(std::size_t bridge, boost::mutex::scoped_lock& lock);
+  void fail(Dispatch& bridge, const std::string& error);
+  void finish(boost::mutex::scoped_lock& lock);
+};
+
+#endif //HOMEACTION_H_
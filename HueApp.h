@@ -1,5 +1,6 @@
 #include <Wt/WContainerWidget>
 
+#include "Route.h"
 #include "Session.h"
 #include "LightsControl.h"
 #include "BridgeControl.h"
@@ -54,7 +55,8 @@ class GroupsSchedulerControlWidget;
 class HueApp : public Wt::WContainerWidget
 {
 public:
-  HueApp(Wt::WContainerWidget *parent = 0);
+  HueApp(Wt::Dbo::SqlConnectionPool& connectionPool, Wt::WContainerWidget *parent = 0);
+  ~HueApp();
 
   void handleInternalPath(const std::string &internalPath);
 
@@ -72,6 +74,7 @@ private:
   Wt::WAnchor *backToGameAnchor_;
 
   Session session_;
+  Route route_;										/*!< the page shown and its parameters */
 
   void onAuthEvent();
   void showLights();
@@ -0,0 +1,83 @@
+/** @file ImagePalette.h
+*  @brief Extracts the dominant colors of a PNG or JPEG image, in process
+*
+*   The image is decoded with libpng/libjpeg (JPEGs are decoded at 1/2, 1/4
+*   or 1/8 scale straight away when they are large), shrunk with a box
+*   filter to at most SampleSide pixels a side, and quantized: median cut
+*   picks the starting colors and a few k-means passes refine them. The
+*   loops run over flat arrays of pixels so the compiler can vectorize them.
+*   No network is involved: a 640x480 JPEG takes about a millisecond, a 12
+*   megapixel one a few tens (most of it entropy decoding, see 'make bench').
+*/
+
+#ifndef IMAGEPALETTE_H_
+#define IMAGEPALETTE_H_
+
+#include <string>
+#include <vector>
+
+namespace ImagePalette {
+
+  /** @brief largest side of the image that is quantized */
+  const int SampleSide = 64;
+
+  /** @brief A decoded image, 3 bytes (R, G, B) per pixel, row by row
+   */
+  struct Image
+  {
+    Image() : width(0), height(0) { }
+
+    int width;
+    int height;
+    std::vector<unsigned char> rgb;
+  };
+
+  /** @brief A color of the palette
+   */
+  struct Rgb
+  {
+    int r;                              /*!< 0 to 255 */
+    int g;                              /*!< 0 to 255 */
+    int b;                              /*!< 0 to 255 */
+    int count;                          /*!< sampled pixels of this color */
+  };
+
+  /** @brief A color as a light state
+   */
+  struct LightColor
+  {
+    int hue;                            /*!< 0 to 65535 */
+    int sat;                            /*!< 0 to 254 */
+    int bri;                            /*!< 1 to 254 */
+  };
+
+  /** @brief decodes a PNG or JPEG file (told apart by their signatures)
+  *
+  *  @param path the file
+  *  @param minSide JPEGs are decoded at the smallest scale that keeps their largest side at least this long, 0 for full size
+  *  @param image the decoded image
+  *  @return false if the file is not a readable PNG or JPEG
+  */
+  bool decode(const std::string& path, int minSide, Image& image);
+
+  /** @brief shrinks an image with a box filter so its largest side is at most maxSide
+  */
+  void downsample(const Image& in, int maxSide, Image& out);
+
+  /** @brief the (at most) count dominant colors of an image, most common first
+  */
+  std::vector<Rgb> quantize(const Image& image, int count);
+
+  /** @brief converts a color to a light's hue, saturation and brightness
+  */
+  LightColor toLightColor(const Rgb& color);
+
+  /** @brief the (at most) count dominant colors of a PNG or JPEG file, most common first
+  *
+  *  @return false if the file is not a readable PNG or JPEG
+  */
+  bool extract(const std::string& path, int count, std::vector<LightColor>& palette);
+
+}
+
+#endif //IMAGEPALETTE_H_
@@ -6,14 +6,20 @@
 */
 
 #include <string>
+#include <vector>
 #include <boost/lexical_cast.hpp>
 #include <boost/system/system_error.hpp>
 #include <Wt/WContainerWidget>
+#include "BridgeEndpoint.h"
+#include "BridgePoller.h"
+#include "Liveness.h"
 
 #ifndef LIGHTCONTROL_H_
 #define LIGHTCONTROL_H_
 
+class LightsModel;
 class Session;
+struct Route;
 
 class LightsControlWidget: public Wt::WContainerWidget
 {
@@ -28,6 +34,12 @@ public:
   *  @return LightsControlWidget
   */
   LightsControlWidget(Session *session, Wt::WContainerWidget *parent = 0);									
+
+  /** @brief destroys a LightsControlWidget
+  *
+  *  stops receiving changes from the bridge's BridgePoller
+  */
+  ~LightsControlWidget();
   
   /** @brief loads LightsControlWidget page
   *
@@ -37,34 +49,42 @@ public:
   */
   void update();												
 
+  /** @brief loads the LightsControlWidget page for the bridge of a route
+  *
+  *  keeps the route's parameters, then calls update()
+  *
+  *  @param route the page and its parameters, parsed by HueApp
+  *  @return Void
+  */
+  void update(const Route& route);
+
 private:
+	Liveness liveness_;								/*!< drops responses that arrive after this is deleted */
 	Session *session_;									/*!< keeps track of light status */
 	std::string currentLight = "0";						/*!< the light that is currently being changed */
 	std::string ip = "";								/*!< bridge's IP address */
 	std::string userID = "";							/*!< user's bridge ID */
 	std::string port = "";								/*!< bridge's port number */
-	std::string customHue;								/*!< custom hue value */
-	std::string customSat;								/*!< custom saturation value */
-	std::string customBri;								/*!< custom brightness value */
+	BridgeEndpoint endpoint_;							/*!< the bridge's request paths, each built once */
+	std::vector<long long> sceneIds_;					/*!< ids of the scenes in sceneChoices_ */
+	int subscription_ = -1;								/*!< BridgePoller subscription, -1 if none */
 	Wt::WLineEdit *nameEdit_;							/*!< light's name to be changed */
 	Wt::WSlider *satScaleSlider_;						/*!< light's saturation selection */
 	Wt::WSlider *briScaleSlider_;						/*!< light's brightness selection */
 	Wt::WSlider *hueScaleSlider_;						/*!< light's hue selection */
 	Wt::WSlider *transitionScaleSlider_;				/*!< light's transition time selection */
-	Wt::WText *oneLight_;								/*!< light 1's name */
-	Wt::WText *twoLight_;								/*!< light 2's name */
-	Wt::WText *threeLight_;								/*!< light 3's name */
+	LightsModel *lightsModel_;							/*!< the bridge's lights, by id */
+	Wt::WTableView *lightsView_;						/*!< table of lights, renders only the visible rows */
 	Wt::WText *change_;									/*!< status of a light change */
 	Wt::WText *light_;									/*!< displays the light being changed */
+	Wt::WText *userInfo_;								/*!< greets the user */
+	Wt::WPushButton *editButton_;						/*!< links to editing the bridge */
+	Wt::WPushButton *groupButton_;						/*!< links to the bridge's groups */
+	Wt::WPushButton *schedulerButton_;					/*!< links to the bridge's schedules */
+	Wt::WLineEdit *sceneNameEdit_;						/*!< name of the scene to save */
+	Wt::WComboBox *sceneChoices_;						/*!< the user's scenes */
+	Wt::WContainerWidget *scenesBox_;					/*!< the user's scenes and their buttons, hidden if there are none */
 	
-	/** @brief creates an HTTP client
-	*
-	*  creates an HTTP client that will be used to send either a put request change a light or a get request to retrive a light's state
-	*
-	*  @return Http::Client
-	*/
-	Wt::Http::Client * connect();
-
 	/** @brief turns a light on
 	*
 	*  turns a light on. A light must be selected first.
@@ -121,29 +141,21 @@ private:
 	*/
 	void transition();	
 
-	/** @brief selects light 1 to change
-	*
-	*  selects light 1 such that any changes in state will be applied to light 1
-	*
-	*  @return Void
-	*/
-	void lightOne();
-
-	/** @brief selects light 2 to change
+	/** @brief lists the user's scenes
 	*
-	*  selects light 2 such that any changes in state will be applied to light 2
+	*  reads the scenes from the scene cache and hides the scenes box if there are none
 	*
 	*  @return Void
 	*/
-	void lightTwo();
+	void showScenes();
 
-	/** @brief selects light 3 to change
+	/** @brief selects the light to change
 	*
-	*  selects light 3 such that any changes in state will be applied to light 3
+	*  selects the light of the row chosen in the lights table such that any changes in state will be applied to it, and shows its values on the sliders
 	*
 	*  @return Void
 	*/
-	void lightThree();
+	void selectLight();
 
 	/** @brief returns user to the bridge page
 	*
@@ -161,35 +173,48 @@ private:
 	*/
 	void deleteBridge();
 
-	/** @brief creates a custom light mode
+	/** @brief saves a scene
 	*
-	*  takes the chosen hue, saturation and brightness values from the sliders and creates a custom mode button. If custom moe already exits, new custom mode overrides the old one.
+	*  saves the state of every light on the bridge as a new scene with the entered name, taking the selected light's hue, saturation and brightness from the sliders. A user can have any number of scenes.
 	*
 	*  @return Void
 	*/
-	void customCreate();
+	void saveScene();
 
-	/** @brief implementss acustom light mode
+	/** @brief applies a scene
 	*
-	*  changes a light to the hue, saturation and brightness in the custom mode
+	*  queues the scene's state for every light of the bridge it has one for (by id, or by position for a positional scene), all in one go
+	*
+	*  @return Void
+	*/
+	void applyScene();
+
+	/** @brief deletes the chosen scene
 	*
 	*  @return Void
 	*/
-	void customMode();
+	void deleteScene();
 
-	/** @brief handles response and displays light information
+	/** @brief displays the lights
 	*
-	*  gets the current state of a light and adjusts the slider values to reflect the light's state. Called when a user chooses a light to change
+	*  fills the lights table with every light on the bridge and its current state, as held by the bridge's model
 	*
-	*  @param err the response's error code
-	*  @param response the response
 	*  @return Void
 	*/
-	void handleHttpResponse(boost::system::error_code err, const Wt::Http::Message& response);
-	
-	/** @@brief handles response for light name changes
+	void showLights();
+
+	/** @brief shows changes to the lights
+	*
+	*  updates the rows of the lights that were changed on the bridge (by other users, schedules or a switch). Called by the bridge's BridgePoller
+	*
+	*  @param delta the lights and groups that changed
+	*  @return Void
+	*/
+	void lightsChanged(const BridgePoller::Delta& delta);
+
+	/** @brief handles response and displays the lights
 	*
-	*  uses update() to refresh the page with changes to light names. Called whea user change the name of a light
+	*  displays the lights with showLights() once the bridge's model has been fetched
 	*
 	*  @param err the response's error code
 	*  @param response the response
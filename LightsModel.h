@@ -0,0 +1,65 @@
+/** @file LightsModel.h
+*  @brief Table model over the lights of a bridge
+*
+*   Keeps the lights sorted by id, one row per light, so a WTableView only
+*   asks for (and renders) the rows that are visible. A refresh with the same
+*   set of lights only emits dataChanged() for the rows that differ, which
+*   keeps the selection and scroll position of the view.
+*/
+
+#ifndef LIGHTSMODEL_H_
+#define LIGHTSMODEL_H_
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <Wt/WAbstractTableModel>
+
+#include "BridgeJson.h"
+
+class LightsModel : public Wt::WAbstractTableModel
+{
+public:
+  enum Column {
+    IdColumn,
+    NameColumn,
+    OnColumn,
+    BriColumn,
+    HueColumn,
+    SatColumn,
+    ColumnCount
+  };
+
+  LightsModel(Wt::WObject *parent = 0);
+
+  /** @brief replaces all lights, e.g. with the result of GET /lights */
+  void setLights(const std::map<int, LightState>& lights);
+
+  /** @brief updates (or adds) a single light */
+  void setLight(int id, const LightState& light);
+
+  /** @brief the id of the light shown in a row */
+  int lightId(int row) const { return rows_[row].first; }
+
+  /** @brief the state of the light shown in a row */
+  const LightState& light(int row) const { return rows_[row].second; }
+
+  /** @brief the row of a light, or -1 if the bridge has no such light */
+  int row(int id) const;
+
+  virtual int rowCount(const Wt::WModelIndex& parent = Wt::WModelIndex()) const;
+  virtual int columnCount(const Wt::WModelIndex& parent = Wt::WModelIndex()) const;
+  virtual boost::any data(const Wt::WModelIndex& index, int role = Wt::DisplayRole) const;
+  virtual boost::any headerData(int section, Wt::Orientation orientation = Wt::Horizontal,
+				int role = Wt::DisplayRole) const;
+
+private:
+  typedef std::pair<int, LightState> Row;
+
+  std::vector<Row> rows_;             /*!< lights, sorted by id */
+
+  static bool sameState(const LightState& a, const LightState& b);
+};
+
+#endif //LIGHTSMODEL_H_
@@ -0,0 +1,67 @@
+/** @file Liveness.h
+*  @brief Drops callbacks whose widget has been deleted
+*
+*   Bridge responses and whole home reports are posted back into the session
+*   that asked for them, and may arrive after the widget that asked is gone:
+*   logging out clears the main stack while requests are in flight. A widget
+*   keeps a Liveness member and wraps the callbacks that bind its this
+*   pointer with guard(). Once the widget, and so the member, is destroyed
+*   the wrapped callbacks do nothing.
+*
+*   Callbacks and widget destruction both run inside the session, so the
+*   check cannot race with the destruction.
+*/
+
+#ifndef LIVENESS_H_
+#define LIVENESS_H_
+
+#include <utility>
+
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
+
+class Liveness : boost::noncopyable
+{
+public:
+  template <typename F>
+  class Guarded
+  {
+  public:
+    Guarded(const boost::weak_ptr<void>& alive, const F& function)
+      : alive_(alive),
+	function_(function)
+    { }
+
+    template <typename... Args>
+    void operator()(Args&&... args) const
+    {
+      if (!alive_.expired())
+	function_(std::forward<Args>(args)...);
+    }
+
+  private:
+    boost::weak_ptr<void> alive_;
+    F function_;
+  };
+
+  Liveness()
+    : alive_(new char())
+  { }
+
+  /** @brief wraps a callback so that it is not called once this is destroyed
+  *
+  *  @param function usually a boost::bind of a member function and the owner's this
+  *  @return a function object taking the same arguments
+  */
+  template <typename F>
+  Guarded<F> guard(const F& function) const
+  {
+    return Guarded<F>(alive_, function);
+  }
+
+private:
+  boost::shared_ptr<char> alive_;
+};
+
+#endif //LIVENESS_H_
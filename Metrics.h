@@ -0,0 +1,172 @@
+/** @file Metrics.h
+*  @brief Counters, gauges and latency histograms, served by MetricsResource
+*
+*   Series are registered once by name and labels, e.g.
+*
+*     static Metrics::Histogram& queryTime = Metrics::instance().histogram(
+*       "hue_db_query_seconds", "...", Metrics::Labels{{"method", "getBridge"}});
+*     Metrics::Timer timer(queryTime);
+*
+*   and the reference is kept: looking a series up takes the registry's
+*   lock, recording into it does not. Every series has a slot per thread
+*   (threads are spread over Slots slots, each a cache line long) that is
+*   only updated with relaxed atomic adds, so threads recording at the same
+*   time do not contend; the slots are summed when the metrics are written.
+*
+*   Metrics are written in the Prometheus text format.
+*/
+
+#ifndef METRICS_H_
+#define METRICS_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/thread/mutex.hpp>
+
+class Metrics
+{
+public:
+  typedef std::vector<std::pair<std::string, std::string> > Labels;
+
+  static const unsigned Slots = 16;     /*!< threads share a slot beyond this many */
+
+  /** @brief a series of a metric, see counter(), gauge() and histogram()
+   */
+  class Series
+  {
+  public:
+    virtual ~Series() { }
+    virtual void write(std::ostream& out, const std::string& name, const std::string& labels) const = 0;
+  };
+
+  /** @brief a count that only goes up
+   */
+  class Counter : public Series
+  {
+  public:
+    Counter();
+
+    void add(std::uint64_t n = 1) { cells_[slot()].value.fetch_add(n, std::memory_order_relaxed); }
+    std::uint64_t value() const;
+
+    virtual void write(std::ostream& out, const std::string& name, const std::string& labels) const;
+
+  private:
+    struct Cell { std::atomic<std::uint64_t> value; char pad[56]; };
+    Cell cells_[Slots];
+  };
+
+  /** @brief a value that goes up and down, e.g. sessions
+   */
+  class Gauge : public Series
+  {
+  public:
+    Gauge();
+
+    void add(std::int64_t n = 1) { cells_[slot()].value.fetch_add(n, std::memory_order_relaxed); }
+    void sub(std::int64_t n = 1) { add(-n); }
+    std::int64_t value() const;
+
+    virtual void write(std::ostream& out, const std::string& name, const std::string& labels) const;
+
+  private:
+    struct Cell { std::atomic<std::int64_t> value; char pad[56]; };
+    Cell cells_[Slots];
+  };
+
+  /** @brief durations, counted in fixed buckets from 1 ms to 15 s
+   */
+  class Histogram : public Series
+  {
+  public:
+    static const unsigned BucketCount = 14;            /*!< plus one for anything longer */
+    static const std::int64_t BoundsUs[BucketCount];   /*!< upper bound of each bucket */
+
+    Histogram();
+
+    void record(std::chrono::steady_clock::duration duration);
+    void recordMicroseconds(std::int64_t us);
+
+    virtual void write(std::ostream& out, const std::string& name, const std::string& labels) const;
+
+  private:
+    struct Cell                         /* 128 bytes */
+    {
+      std::atomic<std::uint64_t> buckets[BucketCount + 1];
+      std::atomic<std::uint64_t> sumUs;
+    };
+    Cell cells_[Slots];
+  };
+
+  /** @brief records the time until it goes out of scope
+   */
+  class Timer
+  {
+  public:
+    explicit Timer(Histogram& histogram)
+      : histogram_(histogram), start_(std::chrono::steady_clock::now()) { }
+    ~Timer() { histogram_.record(std::chrono::steady_clock::now() - start_); }
+
+  private:
+    Histogram& histogram_;
+    std::chrono::steady_clock::time_point start_;
+  };
+
+  /** @brief the server-wide metrics
+  *
+  *  @return Metrics
+  */
+  static Metrics& instance();
+
+  /** @brief the series of a metric with these labels, created the first time
+  *
+  *  @param name metric name, e.g. hue_bridge_timeouts_total
+  *  @param help one line describing the metric, the first registration's is used
+  *  @param labels label names and values of the series
+  *  @throws std::invalid_argument if the name is registered as another type
+  */
+  Counter& counter(const std::string& name, const std::string& help, const Labels& labels = Labels());
+  Gauge& gauge(const std::string& name, const std::string& help, const Labels& labels = Labels());
+  Histogram& histogram(const std::string& name, const std::string& help, const Labels& labels = Labels());
+
+  /** @brief writes every series in the Prometheus text format (version 0.0.4)
+  */
+  void write(std::ostream& out);
+
+  /*
+   * Counted for the current Wt session, call from inside it
+   */
+  static void sessionStarted();
+  static void sessionEnded();           /*!< also forgets its renders still deferred */
+  static void deferRendering();         /*!< WApplication::deferRendering(), counted */
+  static void resumeRendering();        /*!< WApplication::resumeRendering(), counted if the session deferred */
+
+private:
+  struct Family
+  {
+    Family() : type(0) { }
+
+    std::string help;
+    const char *type;
+    std::map<std::string, std::unique_ptr<Series> > series;  /*!< by formatted labels */
+  };
+
+  boost::mutex mutex_;
+  std::map<std::string, Family> families_;
+
+  Metrics();
+
+  static unsigned slot();
+  template <typename T>
+  T& series(const std::string& name, const std::string& help, const char *type, const Labels& labels);
+};
+
+#endif //METRICS_H_
@@ -0,0 +1,24 @@
+/** @file MetricsResource.h
+*  @brief Serves the server's Metrics at /metrics
+*
+*   Registered by main() as a static resource, so reading it needs no
+*   session. The response is the Prometheus text format, for a scraper or
+*   'curl http://host:port/metrics'.
+*/
+
+#ifndef METRICSRESOURCE_H_
+#define METRICSRESOURCE_H_
+
+#include <Wt/WResource>
+
+class MetricsResource : public Wt::WResource
+{
+public:
+  MetricsResource(Wt::WObject *parent = 0);
+  ~MetricsResource();
+
+protected:
+  virtual void handleRequest(const Wt::Http::Request& request, Wt::Http::Response& response);
+};
+
+#endif //METRICSRESOURCE_H_
@@ -0,0 +1,51 @@
+/** @file Route.h
+*  @brief The page an internal path leads to, and its parameters
+*
+*   Links to pages look like /lights?user=<id>&ip=<ip>&port=<port> (with
+*   the '&' escaped as %26 when they go through a URL). HueApp parses the
+*   internal path into a Route once when it changes and hands it to the
+*   page, instead of every page finding its parameters in the path again.
+*
+*   Pages are told apart by the whole first segment of the path, so
+*   /group and /groupscheduler no longer depend on the order they are
+*   checked in. Parsing reuses the buffers of the Route's strings, so a
+*   Route that is kept around (HueApp has one) does not allocate.
+*/
+
+#ifndef ROUTE_H_
+#define ROUTE_H_
+
+#include <string>
+
+struct Route
+{
+  enum Page {
+    NoPage,                             /*!< unknown path */
+    Bridges,                            /*!< /bridge, BridgeControlWidget */
+    EditBridge,                         /*!< /editbridge, BridgeEditControlWidget */
+    Lights,                             /*!< /lights (or /light), LightsControlWidget */
+    Groups,                             /*!< /group, GroupsControlWidget */
+    SingleGroup,                        /*!< /singlegroup, SingleGroupsControlWidget */
+    GroupSchedule,                      /*!< /groupscheduler, GroupsSchedulerControlWidget */
+    Schedules,                          /*!< /scheduler, SchedulerControlWidget */
+    SingleSchedule                      /*!< /singlescheduler, SingleSchedulerControlWidget */
+  };
+
+  Route() : page(NoPage) { }
+
+  Page page;
+  std::string userID;                   /*!< user= the user's bridge ID */
+  std::string ip;                       /*!< ip= the bridge's IP address */
+  std::string port;                     /*!< port= the bridge's port number */
+  std::string groupID;                  /*!< groupid= */
+  std::string scheduleID;               /*!< scheduleid= */
+  std::string name;                     /*!< name= a new schedule's name */
+
+  /** @brief parses an internal path, parameters that are not in it are cleared
+  *
+  *  @param internalPath e.g. /lights?user=newdeveloper&ip=192.168.0.2&port=80
+  */
+  void parse(const std::string& internalPath);
+};
+
+#endif //ROUTE_H_
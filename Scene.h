@@ -0,0 +1,46 @@
+/** @file Scene.h
+*  @class Scene
+*  @brief A light scene saved by a user
+*
+*   A scene is either a state per light id, as saved from the lights page,
+*   or a list of states applied by position. A light that has a state in a
+*   per-light scene gets it, the others are left alone. Applied by position,
+*   the n-th light gets state n % (number of states): a scene with one state
+*   sets every light the same, one with three cycles through them like the
+*   presets do. The states are stored as the JSON bodies sent to the bridge,
+*   in an object keyed by light id, e.g. {"1":{"on":true,"bri":211},"3":{"on":false}},
+*   or in an array for a positional scene, e.g.
+*   [{"on":true,"hue":10532,"sat":103,"bri":211}], and are read through the
+*   SceneCache.
+*/
+#ifndef SCENE_H_
+#define SCENE_H_
+
+#include <Wt/Dbo/Types>
+#include <Wt/Dbo/WtSqlTraits>
+
+#include <string>
+#include "User.h"
+
+class Scene
+{
+public:
+  std::string name;
+  std::string states;                   //JSON object (by light id) or array of light states
+  Wt::Dbo::ptr<User> user;
+
+  Scene() { }
+
+  Scene(Wt::Dbo::ptr<User> owner, const std::string& sceneName, const std::string& sceneStates)
+    : name(sceneName), states(sceneStates), user(owner) { }
+
+  template<class Action>
+  void persist(Action& a)
+  {
+    Wt::Dbo::field(a, name, "name");
+    Wt::Dbo::field(a, states, "states");
+    Wt::Dbo::belongsTo(a, user, "user");
+  }
+};
+
+#endif //SCENE_H_
@@ -0,0 +1,103 @@
+/** @file SceneCache.h
+*  @brief Server-wide cache of the users' scenes, ready to be sent
+*
+*   Session loads a user's scenes from the database the first time they are
+*   needed and keeps them here, shared by all of the user's sessions, until
+*   one of them is added or deleted. Every state's request body is
+*   serialized when the scene is loaded, so applying a scene only looks its
+*   bodies up: nothing is parsed or formatted per light.
+*/
+
+#ifndef SCENECACHE_H_
+#define SCENECACHE_H_
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/thread/mutex.hpp>
+
+#include "CommandQueue.h"
+
+class SceneCache
+{
+public:
+  /** @brief a scene, ready to send
+   */
+  struct Entry
+  {
+    long long id;                       /*!< id of the Scene in the database */
+    std::string name;                   /*!< scene name */
+    std::vector<LightCommand> states;   /*!< light states, at least one */
+    std::vector<std::string> bodies;    /*!< states[i].toJson(), the body of a /state or /action PUT */
+    std::vector<int> lights;            /*!< id of the light each state is for, empty if the scene is positional */
+
+    /** @brief the state for a light the scene is applied to
+    *
+    *  @param n position of the light among the lights the scene is applied to
+    *  @param light id of the light
+    *  @return index of its state in states and bodies, -1 if the scene leaves the light alone
+    */
+    int state(std::size_t n, int light) const;
+
+    /** @brief the body for a light the scene is applied to, null if the scene leaves it alone */
+    const std::string *body(std::size_t n, int light) const
+    {
+      int i = state(n, light);
+      return i < 0 ? 0 : &bodies[i];
+    }
+  };
+
+  typedef std::shared_ptr<const Entry> EntryPtr;
+  typedef std::shared_ptr<const std::vector<EntryPtr> > ScenesPtr;
+
+  /** @brief the server-wide cache
+  *
+  *  @return SceneCache
+  */
+  static SceneCache& instance();
+
+  /** @brief the scenes of a user, in the order they were created
+  *
+  *  @param userId id of the User
+  *  @param version set to the version to pass to set() if they are not cached
+  *  @return the scenes, null if they are not cached
+  */
+  ScenesPtr scenes(long long userId, unsigned long *version = 0);
+
+  /** @brief caches the scenes of a user, loaded after scenes() missed
+  *
+  *  Dropped if any user's scenes were invalidated since, as they may have
+  *  been loaded before the change.
+  */
+  void set(long long userId, const ScenesPtr& scenes, unsigned long version);
+
+  /** @brief forgets the scenes of a user, after they changed */
+  void invalidate(long long userId);
+
+  /** @brief makes an entry from a stored scene
+  *
+  *  @param id id of the Scene
+  *  @param name scene name
+  *  @param states the stored JSON object or array of states
+  *  @return the entry, null if the states are invalid or there are none
+  */
+  static EntryPtr entry(long long id, const std::string& name, const std::string& states);
+
+  /** @brief the JSON array of states stored for a positional scene */
+  static std::string serialize(const std::vector<LightCommand>& states);
+
+  /** @brief the JSON object of states stored for a scene of a state per light id */
+  static std::string serialize(const std::map<int, LightCommand>& states);
+
+private:
+  SceneCache();
+
+  boost::mutex mutex_;                  /*!< protects scenes_ and version_ */
+  std::map<long long, ScenesPtr> scenes_;  /*!< by user id */
+  unsigned long version_;               /*!< incremented by every invalidate() */
+};
+
+#endif //SCENECACHE_H_
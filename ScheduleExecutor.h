@@ -0,0 +1,114 @@
+/** @file ScheduleExecutor.h
+*  @brief Fires the schedules kept by this server, see ServerSchedule
+*
+*   Some bridges do not keep their schedules reliably (the emulator's stop
+*   working after one is deleted, and none repeats). With the
+*   "server-schedules" property set to true, the scheduler pages save their
+*   schedules in the database instead, and this server sends their commands
+*   when they are due.
+*
+*   Pending schedules are kept in a TimerWheel, so adding, removing and
+*   firing one takes the same time however many are waiting. Once a second
+*   the wheel is advanced to the current time and the commands that came
+*   due are sent at Bulk priority. A weekly schedule is then put back in the
+*   wheel for its next day, a one time schedule is disabled in the database.
+*
+*   Only the schedules are stored, not when they fire: on start they are
+*   loaded a page at a time on the server's io service, and when each fires
+*   next is worked out from its time then. One time schedules that were due
+*   while the server was down are disabled without being sent.
+*/
+
+#ifndef SCHEDULEEXECUTOR_H_
+#define SCHEDULEEXECUTOR_H_
+
+#include <ctime>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include <boost/asio/deadline_timer.hpp>
+#include <boost/system/error_code.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <Wt/Dbo/SqlConnectionPool>
+#include <Wt/Http/Message>
+
+#include "ServerSchedule.h"
+#include "TimerWheel.h"
+
+class Session;
+
+class ScheduleExecutor
+{
+public:
+  static const int PageSize = 1000;     /*!< schedules loaded per query on start */
+
+  /** @brief the server-wide schedule executor
+  *
+  *  @return ScheduleExecutor
+  */
+  static ScheduleExecutor& instance();
+
+  /** @brief starts firing the stored schedules, if the "server-schedules" property is true
+  *
+  *  Call before the server runs; the schedules are loaded once it does.
+  *
+  *  @param connectionPool the database, it must outlive stop()
+  */
+  void start(Wt::Dbo::SqlConnectionPool& connectionPool);
+
+  /** @brief stops firing schedules, call after the server has stopped
+  */
+  void stop();
+
+  /** @brief whether schedules are kept by this server instead of the bridges
+  */
+  bool enabled();
+
+  /** @brief saves a schedule for the session's user and starts waiting for it
+  *
+  *  @param session the session of the logged in user
+  *  @param schedule the schedule, its id is ignored
+  *  @return false if it was not saved because it never fires (its time has passed or is not understood)
+  */
+  bool add(Session& session, ScheduledCommand schedule);
+
+  /** @brief deletes one of the schedules of the session's user
+  *
+  *  @param session the session of the logged in user
+  *  @param id the schedule's id
+  *  @return false if it is not one of the user's
+  */
+  bool remove(Session& session, long long id);
+
+  /** @brief when a schedule fires next
+  *
+  *  @param time the schedule's time, "YYYY-MM-DDThh:mm:ss" or "W<days>/Thh:mm:ss", in local time
+  *  @param after only times later than this count
+  *  @return the time, -1 if there is none
+  */
+  static std::time_t nextFire(const std::string& time, std::time_t after);
+
+private:
+  ScheduleExecutor();
+
+  boost::mutex mutex_;                  /*!< protects enabled_, wheel_, schedules_ and timer_ */
+  bool enabled_;
+  std::unique_ptr<TimerWheel> wheel_;
+  std::unordered_map<long long, ScheduledCommand> schedules_;  /*!< the ones in wheel_, by id */
+  std::unique_ptr<boost::asio::deadline_timer> timer_;
+
+  boost::mutex dbMutex_;                /*!< protects session_ */
+  std::unique_ptr<Session> session_;    /*!< used for loading and disabling schedules only */
+
+  bool schedule(const ScheduledCommand& schedule, std::time_t now);
+  void unschedule(long long id);
+  void load(long long afterId);
+  void disable(long long id);
+  void wait();
+  void tick(const boost::system::error_code& err);
+  static void fired(long long id, boost::system::error_code err, const Wt::Http::Message& response);
+};
+
+#endif //SCHEDULEEXECUTOR_H_
@@ -6,11 +6,13 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/system/system_error.hpp>
 #include <Wt/WContainerWidget>
+#include "Liveness.h"
 
 #ifndef SCHEDULERCONTROL_H_
 #define SCHEDULERCONTROL_H_
 
 class Session;
+struct Route;
 
 class SchedulerControlWidget: public Wt::WContainerWidget
 {
@@ -33,7 +35,17 @@ public:
 	*/
 	void update();
 
+	/** @brief loads the SchedulerControlWidget page for the bridge of a route
+	*
+	*  keeps the route's parameters, then calls update()
+	*
+	*  @param route the page and its parameters, parsed by HueApp
+	*  @return Void
+	*/
+	void update(const Route& route);
+
 private:
+	Liveness liveness_;								/*!< drops responses that arrive after this is deleted */
 	int numOfSchedules;                                                /*!< keeps track of number of Schedules */
 	Session *session_;                                                 /*!< keeps track of current session */
 	std::string ip = "";											   /*!< keeps track of IP  */
@@ -45,14 +57,33 @@ private:
 	Wt::WLineEdit *nameEdit_;										   /*!< displays name */
 	Wt::WPushButton *createButton;								       /*!< displays a button to create Schedule*/
 	Wt::WText *status_;											       /*!< displays current status */
-	Wt::WText *Schedules_;											   /*!< displays the schedules */
-	/** @brief creates an HTTP Client
+	Wt::WContainerWidget *Schedules_;								   /*!< displays the schedules */
+	Wt::WContainerWidget *serverSchedules_;							   /*!< displays the schedules kept by the server */
+	Wt::WText *userInfo_;											   /*!< greeting in the top left corner */
+	Wt::WPushButton *lightButton_;									   /*!< link back to the lights page */
+
+	/** @brief displays the schedules
+	*
+	*  displays each schedule in the bridge's model as a button that leads to the SingleSchedulerControlWidget where user can edit a specific schedule
+	*
+	*  @return Void
+	*/
+	void showSchedules();
+
+	/** @brief displays the schedules kept by the server
+	*
+	*  displays the user's schedules on this bridge that the server fires, each with a button to delete it
 	*
-	*  creates an HTTP client that will be used to send either a post request to create a new group or a get request to retrieve the currently existing groups
+	*  @return Void
+	*/
+	void showServerSchedules();
+
+	/** @brief deletes a schedule kept by the server
 	*
-	*  @return Http::Client
+	*  @param id the schedule's id
+	*  @return Void
 	*/
-	Wt::Http::Client * connect();		                              
+	void deleteServerSchedule(long long id);
 
 	/** @brief handles response and displays group information
 	*
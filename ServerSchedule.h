@@ -0,0 +1,67 @@
+/** @file ServerSchedule.h
+*  @class ServerSchedule
+*  @brief A schedule kept and fired by this server instead of the bridge
+*
+*   Used when the "server-schedules" property is true, see ScheduleExecutor.
+*   A schedule is the command a bridge schedule would send (method, address
+*   and body, as in the Hue API) and its time, either one date and time
+*   ("2017-11-28T18:30:00") or a weekly one ("W124/T07:00:00", the days as
+*   the bits 0MTWTFSS). Only this is stored: when the schedule next fires is
+*   worked out from its time whenever it is loaded or has fired.
+*/
+#ifndef SERVERSCHEDULE_H_
+#define SERVERSCHEDULE_H_
+
+#include <Wt/Dbo/Types>
+#include <Wt/Dbo/WtSqlTraits>
+
+#include <string>
+#include "User.h"
+
+class ServerSchedule
+{
+public:
+  std::string name;
+  std::string ip;                       //bridge's IP address
+  std::string port;                     //bridge's port number
+  std::string method;                   //e.g. PUT
+  std::string address;                  //e.g. /api/<user>/groups/1/action
+  std::string body;                     //JSON body of the command
+  std::string time;                     //when it fires, see above
+  bool enabled;                         //false once a one time schedule has fired or was missed
+  Wt::Dbo::ptr<User> user;
+
+  ServerSchedule() : enabled(true) { }
+
+  template<class Action>
+  void persist(Action& a)
+  {
+    Wt::Dbo::field(a, name, "name");
+    Wt::Dbo::field(a, ip, "ip");
+    Wt::Dbo::field(a, port, "port");
+    Wt::Dbo::field(a, method, "method");
+    Wt::Dbo::field(a, address, "address");
+    Wt::Dbo::field(a, body, "body");
+    Wt::Dbo::field(a, time, "time");
+    Wt::Dbo::field(a, enabled, "enabled");
+    Wt::Dbo::belongsTo(a, user, "user");
+  }
+};
+
+/** @brief A ServerSchedule as plain values, as Session hands them out
+ */
+struct ScheduledCommand
+{
+  ScheduledCommand() : id(-1) { }
+
+  long long id;
+  std::string name;
+  std::string ip;
+  std::string port;
+  std::string method;
+  std::string address;
+  std::string body;
+  std::string time;
+};
+
+#endif //SERVERSCHEDULE_H_
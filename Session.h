@@ -14,18 +14,24 @@
 #ifndef SESSION_H_
 #define SESSION_H_
 
+#include <map>
 #include <vector>
 #include <string>
 
+#include <boost/function.hpp>
+
 #include <Wt/Auth/Login>
 
 #include <Wt/Dbo/Session>
 #include <Wt/Dbo/ptr>
-#include <Wt/Dbo/backend/Sqlite3>
+#include <Wt/Dbo/SqlConnectionPool>
 
 #include "User.h"
 #include "Bridge.h"
 #include "BridgeUserIds.h"
+#include "Scene.h"
+#include "SceneCache.h"
+#include "ServerSchedule.h"
 
 typedef Wt::Auth::Dbo::UserDatabase<AuthInfo> UserDatabase;
 
@@ -36,13 +42,31 @@ typedef Wt::Dbo::ptr<User> UserPtr;
 typedef Wt::Dbo::ptr<BridgeUserIds> BridgeUserIds_Ptr;
 
 
+/** @brief The logged in user's profile, cached by the Session
+ *
+ *  Loaded in one transaction when the user logs in, so that building a page
+ *  does not query the database. The Session reloads it after changing the
+ *  user or their bridges.
+ */
+struct UserProfile
+{
+  UserProfile() : id(-1) { }
+
+  long long id;                         //id of the User, -1 if no user is logged in
+  std::string firstName;
+  std::string lastName;
+  std::string email;
+  std::vector<Bridge> bridges;          //bridges of the user
+};
+
 
 class Session
 {
 public:
   static void configureAuth();
+  static Wt::Dbo::SqlConnectionPool *createConnectionPool(const std::string& sqliteDb); //shared by all sessions, creates the schema
 
-  Session();
+  Session(Wt::Dbo::SqlConnectionPool& connectionPool);
   ~Session();
 
   Wt::Auth::AbstractUserDatabase& users();
@@ -55,6 +79,7 @@ public:
   std::string userName() const;
   std::string firstName();
   std::string lastName();
+  const UserProfile& profile();         //cached, loaded at login
 
   //-------------------------
   //---------User DB--------
@@ -84,6 +109,27 @@ public:
   void deleteAllBridgeUserId(std::string ip, std::string port); 
   void deleteAllBridgeUserId(Bridge *bridgeObj); 
 
+  //-------------------------
+  //---------Scene DB--------
+  //-------------------------
+  SceneCache::ScenesPtr scenes();       //of the currently logged in user, from the SceneCache
+  SceneCache::EntryPtr scene(long long id); //one of the user's scenes, null if there is none
+  long long addScene(const std::string& name, const std::map<int, LightCommand>& states); //a state per light id
+  void deleteScene(long long id);
+
+  //-----------------------------------
+  //---------Server schedule DB--------
+  //-----------------------------------
+  long long addServerSchedule(const ScheduledCommand& schedule);    //for the currently logged in user, returns its id
+  std::vector<ScheduledCommand> serverSchedules(std::string ip, std::string port); //the user's that have not expired, on a bridge
+  bool deleteServerSchedule(long long id);                          //false if it is not one of the user's
+
+  /*
+   * For the ScheduleExecutor, of all users
+   */
+  std::vector<ScheduledCommand> enabledServerSchedules(long long afterId, int limit); //by id, from the one after afterId
+  void disableServerSchedule(long long id);
+
   //--------------------------
   //---------Bridge DB--------
   //--------------------------
@@ -98,15 +144,31 @@ public:
   static const Wt::Auth::AuthService& auth();
   static const Wt::Auth::AbstractPasswordService& passwordAuth();
   static const std::vector<const Wt::Auth::OAuthService *>& oAuth();
+  static void verifyPassword(const Wt::Auth::User& user, const Wt::WString& password,
+			     const boost::function<void ()>& done); //on the hash workers, then done() in this session
 
   Wt::Dbo::ptr<User> user();
   Wt::Dbo::ptr<User> user(const Wt::Auth::User& authUser);
 
+  /*
+   * For requests made without logging in, e.g. to the ControlResource
+   */
+  Wt::Auth::User findByAuthToken(const std::string& token);   //user of a "remember me" token, invalid if unknown or expired
+  std::map<std::string, std::string> bridgeUserIds(const Wt::Auth::User& authUser); //the user's bridge user ids by "ip:port"
+
 private:
-  Wt::Dbo::backend::Sqlite3 sqlite3_;
   mutable Wt::Dbo::Session session_;
   UserDatabase *users_;
   Wt::Auth::Login login_;
+  UserProfile profile_;
+  bool profileLoaded_;                  //profile_ is up to date
+
+  void loginChanged();
+  void invalidateProfile();
+
+  static void mapClasses(Wt::Dbo::Session& session);
+  BridgePtr findBridge(const std::string& ip, const std::string& port); //bridge by address
+  Wt::Dbo::Query<BridgeUserIds_Ptr> findBridgeUserIds(const std::string& ip, const std::string& port); //BridgeUserIds "u" joined with their bridge by address
 
   
 };
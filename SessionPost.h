@@ -0,0 +1,40 @@
+/** @file SessionPost.h
+*  @brief Runs a function inside a session from another thread
+*
+*   Bridge responses, BridgePoller changes and password checks finish on
+*   other threads and are handed back to their session with
+*   WServer::post(). They go through here instead, so that a headless
+*   driver (the load test, whose sessions run in Wt::Test::WTestEnvironment
+*   and are not known to the server) can tell its sessions apart and run
+*   the functions itself. Without redirect() this is WServer::post() on
+*   WApplication::sessionId().
+*/
+
+#ifndef SESSIONPOST_H_
+#define SESSIONPOST_H_
+
+#include <string>
+
+#include <boost/function.hpp>
+
+namespace SessionPost {
+
+  typedef boost::function<void ()> Function;
+  typedef boost::function<std::string ()> Identify;
+  typedef boost::function<void (const std::string&, const Function&)> Poster;
+
+  /** @brief the id of the session of the calling thread, empty outside a session */
+  std::string current();
+
+  /** @brief runs function inside the session with this id, dropped if it is gone */
+  void post(const std::string& sessionId, const Function& function);
+
+  /** @brief identifies and runs in sessions with these instead of Wt's
+  *
+  *  Set once, before the first session starts.
+  */
+  void redirect(const Identify& identify, const Poster& poster);
+
+}
+
+#endif //SESSIONPOST_H_
@@ -9,14 +9,20 @@
 */
 
 #include <string>
+#include <vector>
 #include <boost/lexical_cast.hpp>
 #include <boost/system/system_error.hpp>
 #include <Wt/WContainerWidget>
+#include "BridgeEndpoint.h"
+#include "BridgePoller.h"
+#include "ImagePalette.h"
+#include "Liveness.h"
 
 #ifndef SINGLEGROUPCONTROL_H_
 #define SINGLEGROUPCONTROL_H_
 
 class Session;
+struct Route;
 
 class SingleGroupsControlWidget: public Wt::WContainerWidget
 {
@@ -31,6 +37,12 @@ public:
 	*  @return SingleGroupsControlWidget
 	*/
 	SingleGroupsControlWidget(Session *session, Wt::WContainerWidget *parent = 0);
+
+	/** @brief destroys a SingleGroupsControlWidget
+	*
+	*  stops receiving changes from the bridge's BridgePoller
+	*/
+	~SingleGroupsControlWidget();
 	
 	/** @brief loads SingleGroupsControlWidget page
 	*
@@ -40,14 +52,25 @@ public:
 	*/
 	void update();
 
+	/** @brief loads the SingleGroupsControlWidget page for the group of a route
+	*
+	*  keeps the route's parameters, then calls update()
+	*
+	*  @param route the page and its parameters, parsed by HueApp
+	*  @return Void
+	*/
+	void update(const Route& route);
+
 private:
+	Liveness liveness_;								/*!< drops responses that arrive after this is deleted */
 	Session *session_;												/*!< keeps track of group status */
 	std::string groupName = "";										/*!< name of the group */
 	std::string ip = "";											/*!< bridge's IP address */
 	std::string userID = "";										/*!< user's bridge ID */
 	std::string port = "";											/*!< bridge's port number */
 	std::string groupID = "";										/*!< group's ID */
-	std::string lights;												/*!< group's lights */
+	BridgeEndpoint endpoint_;										/*!< the bridge's request paths, each built once */
+	std::vector<int> lights;										/*!< ids of the group's lights */
 	bool deleteConfirm;												/*!< confirmation of intent to delete group */		
 	Wt::WLineEdit *nameEdit_;										/*!< groups' name to be changed */
 	Wt::WText *groupInfoEdit_;										/*!< group name display */
@@ -60,23 +83,55 @@ private:
 	Wt::WComboBox *addChoices_;										/*!< selected light to add to group */
 	Wt::WComboBox *removeChoices_;									/*!< selected light to remove from group */
 	Wt::WFileUpload *upload;
+	Wt::WSound *partySound_;										/*!< party mode's music, played by the browser */
+	Wt::WPushButton *partyPauseButton_;								/*!< pauses/resumes party mode */
+	Wt::WPushButton *uploadButton_;									/*!< sends the picture to take colors from */
+	Wt::WText *userInfo_;											/*!< greeting in the top left corner */
+	Wt::WPushButton *groupButton_;									/*!< link back to the groups page */
+	Wt::WPushButton *scheduleButton_;								/*!< link to the group's scheduler */
+	Wt::WPushButton *lightButton_;									/*!< link back to the lights page */
+	int subscription_ = -1;											/*!< BridgePoller subscription, -1 if none */
 	
-	/** @brief creates an HTTP client
+	/** @brief checks whether a light is in the group
+	*
+	*  @param id the light's id
+	*  @return true if the light is in the group
+	*/
+	bool hasLight(int id) const;
+
+	/** @brief sets a light's state
 	*
-	*  creates an HTTP client that will be used to send either a put request to change the state of a group or a get request to obtain information about the group name/light members
+	*  sends a put request with the given state to the light, at effect priority. Used by the preset modes and images
 	*
-	*  @return Http::Client
+	*  @param id the light's id
+	*  @param body the state, as JSON
+	*  @return Void
 	*/
-	Wt::Http::Client * connect();
+	void setLightState(int id, const std::string& body);
 
-	/** @brief plays music in background
+	/** @brief changes the group's lights to a preset mode
 	*
-	*  plays a .wav file in the background. Used for party mode.
+	*  gives the n-th light of the group the (n % 3)-th shade of the mode, whatever the group's size. The modes are a table in SingleGroupsControl.C
 	*
-	*  @param sound audio file
+	*  @param preset the mode's index in the table
 	*  @return Void
 	*/
-	static void music(Wt::WSound *sound);
+	void applyPreset(int preset);
+
+	/** @brief changes the group's lights to the colors of an image
+	*
+	*  gives the n-th light of the group the (n % size)-th color of the palette
+	*
+	*  @param palette the image's dominant colors, most common first
+	*  @return Void
+	*/
+	void applyPalette(const std::vector<ImagePalette::LightColor>& palette);
+
+	/** @brief identifies the group's effects in the EffectEngine
+	*
+	*  @return ip:port/groups/<groupID>
+	*/
+	std::string effectTarget() const;
 
 	/** @brief turns group's lights on
 	*
@@ -150,104 +205,83 @@ private:
 	*/
 	void removeLights();
 
-	/** @brief puts group on party mode for 10s (color looping). Must wait for party mode to finish. 
+	/** @brief puts group on party mode for 10s (color looping)
 	*
-	*  loops the lights in the group through every 0.25s for 10s. Party.wav plays in the background using music(). User must wait for party mode to finish in order to continue using the server
+	*  loops the lights in the group through 5 colors every 0.25s for 10s, using the EffectEngine, while party.wav plays in the browser. The page can be used (and left) while party mode plays
 	*
 	*  @return Void
 	*/
 	void partyMode();
 
-	/** @brief creates a copy of the current group
+	/** @brief pauses or resumes party mode
 	*
-	*  gets the name and current lights in the group and creates a copy using post request
+	*  pauses party mode and its music if it is playing, resumes it if it is paused
 	*
 	*  @return Void
 	*/
-	void copy();
+	void pauseParty();
 
-	/** @brief puts group on sunset mode (yellows)
+	/** @brief stops party mode
 	*
-	*  turns on all the lights in the group and changes them to a different shade of yellow
+	*  stops party mode and its music. The lights keep their current colors
 	*
 	*  @return Void
 	*/
-	void sunsetMode();
-
-	/** @brief puts group on fifty mode (greys)
-	*
-	*  turns on all the lights in the group and changes them to a different shade of grey
-	*
-	*  @return Void
-	*/
-	void fiftyMode();
-
-
-	/** @brief puts group on mustang mode (purples)
-	*
-	*  turns on all the lights in the group and changes them to a different shade of purple
-	*
-	*  @return Void
-	*/
-	void mustangMode();
-
+	void stopParty();
 
-	/** @brief puts group on blood mode (reds)
+	/** @brief creates a copy of the current group
 	*
-	*  turns on all the lights in the group and changes them to a different shade of red
+	*  gets the name and current lights in the group and creates a copy using post request
 	*
 	*  @return Void
 	*/
-	void bloodMode();
-
+	void copy();
 
-	/** @brief puts group on ocean mode (blues)
+	/** @brief deletes a group
 	*
-	*  turns on all the lights in the group and changes them to a different shade of blue
+	*  deletes the group and returns user back to the bridge page using returnBridge(). The group will no longer be listed as existing and cannot be accessed
 	*
 	*  @return Void
 	*/
-	void oceanMode();
+	void deleteGroup();
 
 
-	/** @brief puts group on fire mode (oranges)
+	/** @brief returns user to bridge page
 	*
-	*  turns on all the lights in the group and changes them to a different shade of orange
+	* returns user the bridge page by setting the internal path
 	*
 	*  @return Void
 	*/
-	void fireMode();
-
+	void returnBridge();
 
-	/** @brief puts group on forest mode (greens)
+	/** @brief displays group information
 	*
-	*  turns on all the lights in the group and changes them to a different shade of green
+	*  gets the group's name and the lights in the group from the bridge's model and displays them, with the lights that can be removed
 	*
 	*  @return Void
 	*/
-	void forestMode();
+	void showGroup();
 
-
-	/** @brief deletes a group
+	/** @brief shows changes to the group
 	*
-	*  deletes the group and returns user back to the bridge page using returnBridge(). The group will no longer be listed as existing and cannot be accessed
+	*  redisplays the group when its name or lights were changed on the bridge, and the lights that can be added when the bridge's lights changed. Called by the bridge's BridgePoller
 	*
+	*  @param delta the lights and groups that changed
 	*  @return Void
 	*/
-	void deleteGroup();
+	void groupChanged(const BridgePoller::Delta& delta);
 
-
-	/** @brief returns user to bridge page
+	/** @brief lists lights that can be added
 	*
-	* returns user the bridge page by setting the internal path
+	*  lists the lights in the bridge's model that are not in the group as choices to add
 	*
 	*  @return Void
 	*/
-	void returnBridge();
+	void showLightChoices();
 
 	/** @brief handles response and displays group information
 	*
-	*  gets the group's name and the lights in the group and displays them
+	*  displays the group with showGroup() once the bridge's model has been fetched
 	*
 	*  @param err the response's error code
 	*  @param response the response
@@ -265,6 +299,16 @@ private:
 	*/
 	void handleHttpResponseUpdate(boost::system::error_code err, const Wt::Http::Message& response);
 
+	/** @brief handles response and lists lights that can be added
+	*
+	*  lists the lights that can be added with showLightChoices() once the bridge's model has been fetched
+	*
+	*  @param err the response's error code
+	*  @param response the response
+	*  @return Void
+	*/
+	void handleHttpResponseLights(boost::system::error_code err, const Wt::Http::Message& response);
+
 	/** @brief handles response and does nothing
 	*
 	*  does nothing. Used for functions where the page does not need to be refreshed nor does group information need to be fetched again.
@@ -275,8 +319,18 @@ private:
 	*/
 	void handleHttpResponseVOID(boost::system::error_code err /*!< error code */, const Wt::Http::Message& response /*!< response */);
 
-	void handleHttpResponseVision(boost::system::error_code err, const Wt::Http::Message& response);
+	/** @brief reports an upload that is too large
+	*
+	*  @return Void
+	*/
 	void fileTooLarge();
+
+	/** @brief colors the group's lights after the uploaded image
+	*
+	*  extracts the dominant colors of the uploaded PNG or JPEG with ImagePalette (in process, no network) and applies them with applyPalette()
+	*
+	*  @return Void
+	*/
 	void fileUploaded();
 };
 
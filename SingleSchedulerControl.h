@@ -5,6 +5,8 @@
 */
 
 #include <Wt/WContainerWidget>
+#include "BridgeEndpoint.h"
+#include "Liveness.h"
 #include <boost/lexical_cast.hpp>
 #include <boost/system/system_error.hpp>
 #include <string>
@@ -14,7 +16,11 @@
 #define SINGLESCHEDULERCONTROL_H_
 
 
+class LightCommand;
+class LightsModel;
 class Session;
+struct Route;
+class TimeOptionsModel;
 
 class SingleSchedulerControlWidget: public Wt::WContainerWidget
 {
@@ -37,7 +43,17 @@ public:
   */
   void update();
 
+  /** @brief loads the SingleSchedulerControlWidget page for the schedule of a route
+  *
+  *  keeps the route's parameters, then calls update()
+  *
+  *  @param route the page and its parameters, parsed by HueApp
+  *  @return Void
+  */
+  void update(const Route& route);
+
 private:
+	Liveness liveness_;								/*!< drops responses that arrive after this is deleted */
 	Session *session_;										/*!< keeps track of light status */
 	Wt::WLineEdit *nameEdit_;								/*!< light's name to be changed */
 	Wt::WLineEdit *hueEdit_;								/*!< Light's hue selection */
@@ -49,11 +65,12 @@ private:
 	Wt::WComboBox *hourInput_ ;								/*!< Select Hour */
 	Wt::WComboBox *minInput_ ;								/*!< Select Min */
 	Wt::WComboBox *secInput_ ;								/*!< Select Sec */
+	TimeOptionsModel *hoursModel_;							/*!< Hours 01-12 for hourInput_ */
+	TimeOptionsModel *sixtyModel_;							/*!< 00-59 for minInput_ and secInput_ */
 	Wt::WComboBox *amSelector_; 							/*!< Select Am/Pm */
-	Wt::WComboBox *reoccurChoices_;							/*!< Select number of reoccurences*/
-	Wt::WText *oneLight_;									/*!< FirstLight */
-	Wt::WText *twoLight_;									/*!< SecondLight */
-	Wt::WText *threeLight_;									/*!< Third Light */
+	Wt::WCheckBox *days_[7];								/*!< Repeats the schedule every week on the checked days, Monday first */
+	LightsModel *lightsModel_;								/*!< the bridge's lights, by id */
+	Wt::WTableView *lightsView_;							/*!< table of lights to choose from */
 	Wt::WText *change_;										/*!< Displays Status of Light*/
 	Wt::WText *light_;										/*!< Displays the selected Light */
 	Wt::WText *dateSelect_; 								/*!< Displays Date */
@@ -61,14 +78,17 @@ private:
 	Wt::WText *scheduleTimeEdit_;							/*!< Displays the Schedule Time Info */
 	Wt::WPushButton *deleteButton;							/*!< Delete Button */
 	Wt::WPushButton *scheduleButton; 						/*!< Schedule Button */
+	Wt::WText *userInfo_;									/*!< Greeting in the top left corner */
+	Wt::WPushButton *schedulesButton_;						/*!< Link to the Schedules page */
 	std::string currentLight = "0";							/*!< Variable for Light */
 	std::string ip = "";									/*!< Variable for ip */
 	std::string userID = "";								/*!< Variable for userID */
 	std::string port = "";									/*!< Variable for Port */
+	BridgeEndpoint endpoint_;								/*!< the bridge's request paths */
 	std::string scheduleID = "";							/*!< Variable for ScheduleID */
 	std::string nameID = "";								/*!< Variable for NameID */
 	std::string name; 										/*!< Variable for name of light */
-  	char Datalight; 										/*!< Variable for schedule information */
+  	int Datalight; 											/*!< id of the light the schedule changes, 0 if none is selected */
   	int Dataon; 											/*!< Variable for schedule information */
   	int Datahue; 											/*!< Variable for schedule information */
   	int Databri;											/*!< Variable for schedule information */
@@ -142,53 +162,53 @@ private:
 	*/
 	void handleHttpResponse(boost::system::error_code err, const Wt::Http::Message& response);
 	
-	/** @brief Handles Https Reponse V2
+	/** @brief Shows the schedule
 	*
-	*  Handles the Https Response for Name
+	*  Displays the schedule's name and time from the bridge's model
 	*
 	*  @return Void
 	*/
-	void handleHttpResponseName(boost::system::error_code err, const Wt::Http::Message& response);
+	void showSchedule();
 
-	/** @brief Handles Https Reponse V3
+	/** @brief Handles Https Reponse V2
 	*
-	*  Handles the Https Response for Void
+	*  Handles the Https Response for Name
 	*
 	*  @return Void
 	*/
-	void handleHttpResponseVOID(boost::system::error_code err, const Wt::Http::Message& response);
+	void handleHttpResponseName(boost::system::error_code err, const Wt::Http::Message& response);
 
-	/** @brief Handles Https Connect 
+	/** @brief Handles the lights response
 	*
-	*  Connects to Https
+	*  Displays the lights with showLights() once the bridge's model has been fetched
 	*
 	*  @return Void
 	*/
-	Wt::Http::Client * connect();
+	void handleHttpResponseLights(boost::system::error_code err, const Wt::Http::Message& response);
 
-	/** @brief Changes Light One
+	/** @brief Shows the lights
 	*
-	*  Change Light One
+	*  Fills the lights table with the lights of the bridge, as held by the bridge's model
 	*
 	*  @return Void
 	*/
-	void lightOne();
+	void showLights();
 
-	/** @brief Changes Light Two
+	/** @brief Handles Https Reponse V3
 	*
-	*  Change Light Two
+	*  Handles the Https Response for Void
 	*
 	*  @return Void
 	*/
-	void lightTwo();
+	void handleHttpResponseVOID(boost::system::error_code err, const Wt::Http::Message& response);
 
-	/** @brief Changes Light Three
+	/** @brief Selects the light to change
 	*
-	*  Change Light Three
+	*  Selects the light of the row chosen in the lights table as the one the schedule changes, and shows its values on the sliders
 	*
 	*  @return Void
 	*/
-	void lightThree();
+	void selectLight();
 
 	/** @brief Returns back to Bridge Page
 	*
@@ -208,7 +228,7 @@ private:
 
 	/** @brief Creates a new schedules
 	*
-	*  Will create a schedule that is stored into the emulator
+	*  Will create a schedule that is stored into the emulator, or in the database if the server keeps schedules
 	*
 	*  @return Void
 	*/
@@ -246,27 +266,27 @@ private:
 	*/
 	void deleteSchedule();
 
-	/** @brief Creates a get Signal
+	/** @brief Creates the schedule's command
 	*
-	*  Creates the body of the get signal
+	*  Collects the light changes that were chosen, the body of the command the schedule sends
 	*
-	*  @return Void
+	*  @return LightCommand
 	*/
-	std::string createBodyMessage();
+	LightCommand createCommand();
 
 	/** @brief Creates a Post Signal
 	*
-	*  Creates the body of the post signal
+	*  Creates the body of the post signal, written without building intermediate strings
 	*
-	*  @return Void
+	*  @return std::string, empty if it does not fit in a BridgeJson::Writer
 	*/
 	std::string createPostMessage();
 
 	/** @brief Creates a Date and Time 
 	*
-	*  Creates the body of the post signal
+	*  Creates the time the schedule fires, e.g. 2017-11-28T18:30:00, or W124/T18:30:00 when days are checked
 	*
-	*  @return Void
+	*  @return std::string
 	*/
 	std::string createDateTime();
 	int count;
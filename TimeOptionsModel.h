@@ -0,0 +1,38 @@
+/** @file TimeOptionsModel.h
+*  @brief Read-only list of two digit numbers for the scheduler time pickers
+*
+*   The hour, minute and second WComboBoxes of the scheduler pages used to
+*   get their 12, 60 and 60 items added one by one, for every page and
+*   every session. This model has no rows of its own: it shows a range of
+*   one process-wide table of "00" to "59", so the pickers keep no option
+*   lists. Wt objects belong to the session that created them, so every
+*   page still has its own (empty) model objects; the minute and second
+*   pickers of a page share one.
+*/
+
+#ifndef TIMEOPTIONSMODEL_H_
+#define TIMEOPTIONSMODEL_H_
+
+#include <Wt/WAbstractListModel>
+
+class TimeOptionsModel : public Wt::WAbstractListModel
+{
+public:
+  /** @brief count numbers starting at first, e.g. (1, 12) for hours
+  *
+  *  first + count may be at most 60
+  */
+  TimeOptionsModel(int first, int count, Wt::WObject *parent = 0);
+
+  /** @brief the number shown in a row */
+  int value(int row) const { return first_ + row; }
+
+  virtual int rowCount(const Wt::WModelIndex& parent = Wt::WModelIndex()) const;
+  virtual boost::any data(const Wt::WModelIndex& index, int role = Wt::DisplayRole) const;
+
+private:
+  int first_;                           /*!< number in the first row */
+  int count_;                           /*!< number of rows */
+};
+
+#endif //TIMEOPTIONSMODEL_H_
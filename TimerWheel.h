@@ -0,0 +1,102 @@
+/** @file TimerWheel.h
+*  @brief Hierarchical timing wheel of one second ticks
+*
+*   Holds any number of timers, each an id and the second it is due, with
+*   O(1) insert and remove. There are Levels wheels of Slots slots: the
+*   first has one slot per second, each next one a slot per turn of the
+*   wheel below it (4 min, 18 h, 194 days, 136 years). A timer goes into the
+*   wheel whose span its due time falls in, and moves down a wheel each time
+*   the wheel below comes round to it, so advancing one second only touches
+*   the timers due in it and, once a turn, one slot of a higher wheel.
+*   Seconds in which nothing can come due are skipped.
+*   Timers more than 136 years ahead wait in a list that is looked at once
+*   every turn of the top wheel.
+*
+*   With 256 slots a timer a week ahead is moved down twice before it is
+*   due, and the second in which a slot of the third wheel comes round moves
+*   the timers of 18 hours at once (64 slots moved a week's timers three
+*   times, and those of 3 days at once).
+*
+*   Not locked: the ScheduleExecutor uses one under its mutex.
+*/
+
+#ifndef TIMERWHEEL_H_
+#define TIMERWHEEL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+class TimerWheel
+{
+public:
+  typedef long long Id;
+
+  static const int Levels = 4;
+  static const int SlotBits = 8;
+  static const int Slots = 1 << SlotBits;
+
+  /** @brief a timer that came due, see advance() */
+  struct Timer
+  {
+    Id id;
+    std::int64_t due;                   /*!< second it was due, e.g. a time_t */
+  };
+
+  /** @brief an empty wheel
+  *
+  *  @param now the current second, e.g. time(0)
+  */
+  explicit TimerWheel(std::int64_t now);
+
+  /** @brief adds a timer, replacing the one with the same id
+  *
+  *  A time that has passed is due at the next advance().
+  *
+  *  @param id the timer's id
+  *  @param due the second it is due
+  */
+  void insert(Id id, std::int64_t due);
+
+  /** @brief removes a timer
+  *
+  *  @return false if there was none with the id
+  */
+  bool remove(Id id);
+
+  bool contains(Id id) const { return timers_.count(id) != 0; }
+  std::size_t size() const { return timers_.size(); }
+  std::int64_t now() const { return now_; }
+
+  /** @brief moves the wheel forward to now, removing the timers due until then
+  *
+  *  @param now the current second; nothing happens if it is not later than now()
+  *  @param expired the timers that came due are appended, earliest first
+  */
+  void advance(std::int64_t now, std::vector<Timer>& expired);
+
+private:
+  struct Entry;
+  typedef std::list<Entry> Slot;
+
+  /* a timer and the slot it is in, so that it can be removed and moved without a search */
+  struct Entry
+  {
+    Timer timer;
+    Slot *slot;
+  };
+
+  std::int64_t now_;                    /*!< last second advanced to */
+  Slot wheels_[Levels][Slots];
+  Slot overflow_;                       /*!< due beyond the top wheel's span */
+  std::size_t counts_[Levels + 1];      /*!< timers in each wheel, and in overflow_ */
+  std::unordered_map<Id, Slot::iterator> timers_;
+
+  Slot& slotFor(std::int64_t due);
+  std::size_t& countOf(const Slot *slot);
+  void cascade(Slot& slot);
+};
+
+#endif //TIMERWHEEL_H_
@@ -35,7 +35,7 @@ public:
   std::string lastName;
   std::string email;
   std::string bridgeUserID;
-  std::string customMode;
+  std::string customMode;               //no longer used, converted to a Scene when the database is opened
   
   Wt::Dbo::collection<Wt::Dbo::ptr<Bridge> > bridges;
   Wt::Dbo::collection< Wt::Dbo::ptr<AuthInfo> > authInfos;